@@ -1,40 +1,72 @@
 // avr.cc
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
+#include <sys/mman.h>
+
 #include "avr.hh"
-#include "instruction.hh"
+#include "engine.hh"
 
-AVR::AVR(const char *fn, const char *tp)
-    : Module()
+// anonymous pages read as zero and are only backed once written
+static struct SRAM &map_sram()
 {
-    memset(sram.bytes, 0, SRAM_SIZE_BYTES);
-    memset(flash.bytes, 0, FLASH_SIZE_BYTES);
+    void *p;
 
-    if(strcasecmp(tp, "elf") == 0)
-    {
-        fprintf(stderr, "unsupported file type -- '%s'\n\n", tp);
-        exit(1);
-    }
-    else if(strcasecmp(tp, "ihex") == 0)
-    {
-        load_ihex(fn);
-    }
-    else if(strcasecmp(tp, "bin") == 0)
+    p = mmap(NULL, SRAM_SIZE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED)
     {
-        load_bin(fn);
-    }
-    else
-    {
-        fprintf(stderr, "unknown file type -- '%s'\n\n", tp);
+        perror("mmap");
         exit(1);
     }
+    return *(struct SRAM *)p;
+}
+
+AVR::AVR(const char *fn, const char *tp)
+    : AVR(FlashImage(fn, tp))
+{
+}
+
+AVR::AVR(const FlashImage &image)
+    : Module(), base_id(0), published_cycle(0), watch_next(1), watch_sp(false), sleeping(false), executed(false), sp(SRAM_SIZE_BYTES - 1), stack_low(SRAM_SIZE_BYTES - 1), stack_limit(0), stack_brkval(-1), sram(map_sram()), flash(image.map()), watched(false), trace(NULL), profile(NULL), callgraph(NULL), metrics(Metrics::local())
+{
+#ifdef AVRE_COVERAGE
+    coverage_map = Coverage::map();
+    coverage_prev = 0;
+#endif
+#ifdef AVRE_CMPLOG
+    cmplog = CmpLog::ring();
+    cmplog_pc = 0;
+    cmplog_reg = 0;
+#endif
+    memset(watch_pages, 0, sizeof(watch_pages));
+
+    // SPH is written first by convention, so the new SP (and any stack
+    // overflow) is only looked at once SPL follows
+    register_handler(AVR_REG_SPH, NULL,
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            sp = (sp & 0xff) | data << 8;
+            return data;
+        });
+    register_handler(AVR_REG_SPL, NULL,
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            sp = (sp & 0xff00) | data;
+            if(sp < stack_low || 0 <= stack_brkval)
+            {
+                stack_check(sp);
+            }
+            return data;
+        });
 }
 
 AVR::~AVR()
 {
+    munmap(&sram, SRAM_SIZE_BYTES);
+    munmap(&flash, FLASH_SIZE_BYTES);
 }
 
 void AVR::initialize()
@@ -44,45 +76,255 @@ void AVR::initialize()
 
 void AVR::reset()
 {
+    publish();
     pc = 0;
     cycle = 0;
+    published_cycle = 0;
+    fault = AVR_FAULT_NONE;
+    sleeping = false;
     irq = 0;
+#ifdef AVRE_COVERAGE
+    coverage_prev = 0;
+#endif
     memset(sram.regs, 0, REGS_SIZE_BYTES);
-    sram.bytes[AVR_REG_SPH] = (SRAM_SIZE_BYTES - 1) >> 8;
-    sram.bytes[AVR_REG_SPL] = (SRAM_SIZE_BYTES - 1) & 0xff;
+    memset(dirty, 1, SRAM_PAGE_COUNT);
+    stack_low = SRAM_SIZE_BYTES - 1;
+    set_sp(SRAM_SIZE_BYTES - 1);
+}
+
+void AVR::publish()
+{
+    Metrics::count(metrics->cycles, cycle - published_cycle);
+    published_cycle = cycle;
 }
 
 void AVR::raise_irq(int num)
 {
-    irq |= (1 << num);
+    irq |= ((uint64_t)1 << num);
+}
+
+bool AVR::pending(int num) const
+{
+    return (irq & ((uint64_t)1 << num)) != 0;
 }
 
 void AVR::register_handler(uint16_t reg, AVR::access_handler read, AVR::access_handler write)
 {
+    std::map<uint16_t, std::pair<access_handler, access_handler>>::iterator it;
+
+    it = watch_wrapped.find(reg);
+    if(it != watch_wrapped.end())
+    {
+        // stays watched
+        it->second = std::make_pair(read, write);
+        return;
+    }
     read_handler[reg] = read;
     write_handler[reg] = write;
 }
 
-void AVR::process()
+void AVR::attach(Module *module)
 {
-    uint16_t inst;
-    int i;
+    peripherals.push_back(module);
+}
+
+void AVR::snapshot(Snapshot &snap)
+{
+    static std::atomic<uint64_t> next_id(1);
+    size_t offset = 0;
 
-    sreg.bits = read_byte(AVR_REG_SREG);
+    snap.id = next_id++;
+    snap.pc = pc;
+    snap.cycle = cycle;
+    snap.fault = fault;
+    snap.sleeping = sleeping;
+    snap.stack_low = stack_low;
+    snap.irq = irq;
+    memcpy(snap.sram.bytes, sram.bytes, SRAM_SIZE_BYTES);
 
-    if(irq && sreg.I)
+    for(Module *module : peripherals)
     {
-        for(i = 0; i < IRQ_COUNT && (irq & (1u << i)) == 0; i++);
-        irq ^= (1u << i);
-        push_word(pc);
-        pc = i;
-        sreg.I = 0;
-        write_byte(AVR_REG_SREG, sreg.bits);
+        offset += module->state_size();
+    }
+    snap.modules.resize(offset);
+    offset = 0;
+    for(Module *module : peripherals)
+    {
+        module->save(snap.modules.data() + offset);
+        offset += module->state_size();
     }
 
-    inst = flash.words[pc++];
-    instructions[inst](this, inst);
-    write_byte(AVR_REG_SREG, sreg.bits);
+    memset(dirty, 0, SRAM_PAGE_COUNT);
+    base_id = snap.id;
+}
+
+void AVR::restore(Snapshot &snap)
+{
+    size_t offset = 0;
+
+    publish();
+    pc = snap.pc;
+    cycle = snap.cycle;
+    published_cycle = cycle;
+    fault = snap.fault;
+    sleeping = snap.sleeping;
+    stack_low = snap.stack_low;
+    irq = snap.irq;
+#ifdef AVRE_COVERAGE
+    coverage_prev = 0;
+#endif
+
+    if(snap.id != 0 && snap.id == base_id)
+    {
+        for(unsigned i = 0; i < SRAM_PAGE_COUNT; i++)
+        {
+            if(dirty[i])
+            {
+                memcpy(sram.bytes + (i << SRAM_PAGE_SHIFT), snap.sram.bytes + (i << SRAM_PAGE_SHIFT), SRAM_PAGE_SIZE);
+            }
+        }
+    }
+    else
+    {
+        memcpy(sram.bytes, snap.sram.bytes, SRAM_SIZE_BYTES);
+    }
+    sreg.bits = sram.bytes[AVR_REG_SREG];
+    sp = sram.bytes[AVR_REG_SPL] | sram.bytes[AVR_REG_SPH] << 8;
+
+    for(Module *module : peripherals)
+    {
+        module->load(snap.modules.data() + offset);
+        offset += module->state_size();
+    }
+
+    memset(dirty, 0, SRAM_PAGE_COUNT);
+    base_id = snap.id;
+}
+
+int AVR::add_watch(uint16_t addr, uint16_t size, uint8_t kind, int16_t value)
+{
+    Watchpoint wp = {watch_next++, addr, size, kind, value};
+
+    for(uint32_t a = addr; a < (uint32_t)addr + size && a < SRAM_SIZE_BYTES; a++)
+    {
+        if(a < REGS_SIZE_BYTES)
+        {
+            watch_register(a);
+        }
+        else if(a == addr || (a & (SRAM_PAGE_SIZE - 1)) == 0)
+        {
+            watch_pages[a >> SRAM_PAGE_SHIFT]++;
+        }
+    }
+    watchpoints.push_back(wp);
+    watched = false;
+    return wp.id;
+}
+
+void AVR::remove_watch(int id)
+{
+    std::vector<Watchpoint>::iterator it;
+    Watchpoint wp;
+
+    for(it = watchpoints.begin(); it != watchpoints.end() && it->id != id; it++);
+    if(it == watchpoints.end())
+    {
+        return;
+    }
+    wp = *it;
+    watchpoints.erase(it);
+
+    for(uint32_t a = wp.addr; a < (uint32_t)wp.addr + wp.size && a < SRAM_SIZE_BYTES; a++)
+    {
+        if(a < REGS_SIZE_BYTES)
+        {
+            unwatch_register(a);
+        }
+        else if(a == wp.addr || (a & (SRAM_PAGE_SIZE - 1)) == 0)
+        {
+            watch_pages[a >> SRAM_PAGE_SHIFT]--;
+        }
+    }
+}
+
+void AVR::watch_access(uint16_t addr, uint8_t data, uint8_t kind)
+{
+    for(const Watchpoint &wp : watchpoints)
+    {
+        if((wp.kind & kind) && (uint16_t)(addr - wp.addr) < wp.size && (wp.value < 0 || wp.value == data))
+        {
+            watched = true;
+            watch_hit.id = wp.id;
+            watch_hit.addr = addr;
+            watch_hit.data = data;
+            watch_hit.kind = kind;
+            return;
+        }
+    }
+}
+
+// pushes, pops and interrupt entry move SP without the SPL and SPH
+// handlers, so their watches are checked here
+void AVR::watch_sp_write()
+{
+    watch_access(AVR_REG_SPL, sp & 0xff, WATCH_WRITE);
+    if(!watched)
+    {
+        watch_access(AVR_REG_SPH, sp >> 8, WATCH_WRITE);
+    }
+}
+
+// registers go through read_handler/write_handler anyway, so a watched
+// one gets a handler that checks and then does what the original did
+void AVR::watch_register(uint16_t addr)
+{
+    if(watch_wrapped.count(addr) != 0)
+    {
+        return;
+    }
+    watch_wrapped[addr] = std::make_pair(read_handler[addr], write_handler[addr]);
+    watch_sp = watch_wrapped.count(AVR_REG_SPL) != 0 || watch_wrapped.count(AVR_REG_SPH) != 0;
+    read_handler[addr] = [this](AVR *avr, uint16_t reg, uint8_t data)
+    {
+        access_handler &read = watch_wrapped[reg].first;
+        data = read ? read(avr, reg, data) : data;
+        watch_access(reg, data, WATCH_READ);
+        return data;
+    };
+    write_handler[addr] = [this](AVR *avr, uint16_t reg, uint8_t data)
+    {
+        access_handler &write = watch_wrapped[reg].second;
+        data = write ? write(avr, reg, data) : data;
+        watch_access(reg, data, WATCH_WRITE);
+        return data;
+    };
+}
+
+void AVR::unwatch_register(uint16_t addr)
+{
+    std::map<uint16_t, std::pair<access_handler, access_handler>>::iterator it;
+
+    for(const Watchpoint &wp : watchpoints)
+    {
+        if((uint16_t)(addr - wp.addr) < wp.size)
+        {
+            return;
+        }
+    }
+    it = watch_wrapped.find(addr);
+    if(it == watch_wrapped.end())
+    {
+        return;
+    }
+    read_handler[addr] = it->second.first;
+    write_handler[addr] = it->second.second;
+    watch_wrapped.erase(it);
+    watch_sp = watch_wrapped.count(AVR_REG_SPL) != 0 || watch_wrapped.count(AVR_REG_SPH) != 0;
+}
+
+void AVR::process()
+{
+    executed = step(this);
 }
 
 uint8_t AVR::read_byte(uint16_t addr)
@@ -101,6 +343,21 @@ void AVR::write_byte(uint16_t addr, uint8_t data)
         data = write_handler[addr](this, addr, data);
     }
     sram.bytes[addr] = data;
+    dirty[addr >> SRAM_PAGE_SHIFT] = 1;
+}
+
+void AVR::poke(uint16_t addr, uint8_t data)
+{
+    sram.bytes[addr] = data;
+    dirty[addr >> SRAM_PAGE_SHIFT] = 1;
+    if(addr == AVR_REG_SPL || addr == AVR_REG_SPH)
+    {
+        sp = sram.bytes[AVR_REG_SPL] | sram.bytes[AVR_REG_SPH] << 8;
+    }
+    else if(addr == AVR_REG_SREG)
+    {
+        sreg.bits = data;
+    }
 }
 
 uint16_t AVR::read_word(uint16_t addr)
@@ -116,46 +373,63 @@ void AVR::write_word(uint16_t addr, uint16_t data)
 
 uint8_t AVR::pop_byte()
 {
-    uint16_t sp;
-    sp = read_word(AVR_REG_SP);
-    write_word(AVR_REG_SP, ++sp);
+    set_sp(sp + 1);
     return read_byte(sp);
 }
 
 void AVR::push_byte(uint8_t data)
 {
-    uint16_t sp;
-    sp = read_word(AVR_REG_SP);
     write_byte(sp, data);
-    write_word(AVR_REG_SP, --sp);
+    set_sp(sp - 1);
 }
 
 uint16_t AVR::pop_word()
 {
-    uint16_t sp;
-    sp = read_word(AVR_REG_SP);
-    write_word(AVR_REG_SP, sp + 2);
-    return read_word(sp + 1);
+    set_sp(sp + 2);
+    return read_word(sp - 1);
 }
 
 void AVR::push_word(uint16_t data)
 {
-    uint16_t sp;
-    sp = read_word(AVR_REG_SP);
     write_word(sp - 1, data);
-    write_word(AVR_REG_SP, sp - 2);
+    set_sp(sp - 2);
+}
+
+// a new low point, or any SP while __brkval is followed: the heap can
+// grow into the stack in use long after SP was last that low
+void AVR::stack_check(uint16_t value)
+{
+    uint16_t limit = stack_limit, brk;
+
+    if(value < stack_low)
+    {
+        stack_low = value;
+    }
+    if(0 <= stack_brkval)
+    {
+        brk = sram.bytes[stack_brkval] | sram.bytes[(stack_brkval + 1) & 0xffff] << 8;
+        if(limit < brk)
+        {
+            limit = brk;
+        }
+    }
+    if(value < limit && fault == AVR_FAULT_NONE)
+    {
+        fprintf(stderr, "stack overflow: SP %04x below %04x at cycle %llu\n", value, limit, (unsigned long long)cycle);
+        fault = AVR_FAULT_STACK;
+    }
 }
 
 void AVR::unimplemented(const char *fn)
 {
     pc--;
     fprintf(stderr, "unimplemented instruction: %s at %x\n", fn + 3, (uint32_t)pc << 1);
-    // TODO: unimplemented instruction
+    fault = AVR_FAULT_UNIMPLEMENTED;
 }
 
 void AVR::illegalinst(uint16_t inst)
 {
     pc--;
     fprintf(stderr, "illegal instruction: %02x %02x at %x\n", inst & 0xff, inst >> 8, (uint32_t)pc << 1);
-    // TODO: illegal instruction
+    fault = AVR_FAULT_ILLEGAL;
 }
@@ -5,9 +5,20 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
+#include <utility>
+#include <vector>
 
 #include "module.hh"
+#include "cmplog.hh"
+#include "coverage.hh"
+#include "image.hh"
+#include "callgraph.hh"
 #include "instruction.hh"
+#include "metrics.hh"
+#include "profile.hh"
+#include "trace.hh"
+#include "watch.hh"
 
 #define SRAM_SIZE_BYTES (0x10000u)
 #define REGS_SIZE_BYTES (0x100u)
@@ -20,11 +31,25 @@
 #define AVR_REG_Y       (28u)
 #define AVR_REG_Z       (30u)
 #define AVR_REG_RAMPZ   (0x5cu)
+#define AVR_REG_MCUCR   (0x55u)
+// I/O space, up to the end of the register file
+#define AVR_IO_START    (0x20u)
+
+#define AVR_MCUCR_SE    (0x20u)
+
+#define SRAM_PAGE_SHIFT (8)
+#define SRAM_PAGE_SIZE  (1u << SRAM_PAGE_SHIFT)
+#define SRAM_PAGE_COUNT (SRAM_SIZE_BYTES >> SRAM_PAGE_SHIFT)
 
 #define FLASH_SIZE_BYTES (0x20000u)
 #define FLASH_SIZE_WORDS (0x10000u)
 
-#define IRQ_COUNT (27)
+#define IRQ_COUNT (35)
+
+#define AVR_FAULT_NONE          (0)
+#define AVR_FAULT_UNIMPLEMENTED (1)
+#define AVR_FAULT_ILLEGAL       (2)
+#define AVR_FAULT_STACK         (3)
 
 struct SREG
 {
@@ -63,50 +88,223 @@ struct FLASH
     };
 };
 
+// the complete machine state; AVR::restore() of the snapshot most recently
+// taken or restored copies back only the SRAM pages written since, any
+// other snapshot (or one filled in by hand with id 0) is copied in full
+struct Snapshot
+{
+    uint64_t id;
+    uint16_t pc;
+    uint64_t cycle;
+    int fault;
+    bool sleeping;
+    uint16_t stack_low;
+    uint64_t irq;
+    struct SRAM sram;
+    std::vector<uint8_t> modules;
+};
+
 class AVR : public Module
 {
 protected:
-    typedef std::function<int(AVR *, uint16_t)> instruction;
+    typedef int (*instruction)(AVR *, uint16_t);
     typedef std::function<uint8_t(AVR *, uint16_t, uint8_t)> access_handler;
 
-    uint32_t irq;
-    uint64_t cycle;
+    uint64_t irq;
+
+#ifdef AVRE_COVERAGE
+    uint8_t *coverage_map;
+    uint16_t coverage_prev;
+#endif
+#ifdef AVRE_CMPLOG
+    CmpLogRing *cmplog;
+    uint16_t cmplog_pc;
+    uint8_t cmplog_reg;
+#endif
+
+    uint8_t dirty[SRAM_PAGE_COUNT];
+    uint64_t base_id;
+    // cycle up to which metrics->cycles has been counted
+    uint64_t published_cycle;
+    // watchpoints per SRAM page, checked by Instrumented; the register
+    // file and I/O space are watched through their access handlers instead
+    uint16_t watch_pages[SRAM_PAGE_COUNT];
+    std::vector<Watchpoint> watchpoints;
+    int watch_next;
+    // the handlers of watched registers, wrapped by the watch handlers
+    std::map<uint16_t, std::pair<access_handler, access_handler>> watch_wrapped;
+    // SPL or SPH is among them; set_sp() writes them around the handlers
+    bool watch_sp;
+
+    void stack_check(uint16_t value);
+    void watch_sp_write();
+    void watch_access(uint16_t addr, uint8_t data, uint8_t kind);
+    void watch_register(uint16_t addr);
+    void unwatch_register(uint16_t addr);
+    std::vector<Module *> peripherals;
 
     access_handler read_handler[REGS_SIZE_BYTES];
     access_handler write_handler[REGS_SIZE_BYTES];
 
     static instruction instructions[INSTRUCTION_SPACE];
 
-    void load_elf(const char *fn);
-    void load_ihex(const char *fn);
-    void load_bin(const char *fn);
+    // the interpreter step, in engine.hh; false for an idle cycle asleep,
+    // when no instruction runs
+    template<class CPU> bool step(CPU *cpu);
 
 public:
     uint16_t pc;
-    struct SRAM sram;
-    struct FLASH flash;
+    uint64_t cycle;
+    int fault;
+    // in SLEEP; each step is then one idle cycle until an interrupt
+    bool sleeping;
+    // whether the last process() ran an instruction, not an idle cycle
+    bool executed;
+    // SPH:SPL, kept in step with the I/O registers
+    uint16_t sp;
+    // lowest SP since reset
+    uint16_t stack_low;
+    // SP below this faults with AVR_FAULT_STACK, 0 for no limit
+    uint16_t stack_limit;
+    // data address of avr-libc's __brkval, -1 for none; while it is
+    // non-zero the heap ends there and SP must stay above that as well,
+    // so with one every SP move is checked, not only new low points
+    int32_t stack_brkval;
+    struct SRAM &sram;
+    struct FLASH &flash;
     struct SREG sreg;
+    // set by an access matching a watchpoint, described by watch_hit
+    bool watched;
+    WatchHit watch_hit;
+    // records every step when set, on an Instrumented core
+    Trace *trace;
+    // counts every instruction when set, on an Instrumented core
+    Profile *profile;
+    // follows calls and returns when set, on an Instrumented core
+    CallGraph *callgraph;
+    // the counters of the thread that constructed the core; only an
+    // Instrumented core counts interrupts and I/O accesses
+    Metrics *metrics;
 
     AVR(const char *fn, const char *tp);
+    AVR(const FlashImage &image);
     virtual ~AVR();
 
     virtual void initialize();
     virtual void process();
 
     void reset();
+    // adds the cycles run since the last call to metrics
+    void publish();
     void raise_irq(int num);
+    // raised and not taken yet
+    bool pending(int num) const;
     void register_handler(uint16_t reg, access_handler read, access_handler write);
 
+    // attached peripherals are included in snapshots
+    void attach(Module *module);
+    void snapshot(Snapshot &snap);
+    void restore(Snapshot &snap);
+
+    // returns an id for remove_watch(); watches on SRAM, and on SP as
+    // pushes and pops move it, are only seen by an Instrumented core
+    int add_watch(uint16_t addr, uint16_t size, uint8_t kind, int16_t value);
+    void remove_watch(int id);
+
     uint8_t read_byte(uint16_t addr);
     void write_byte(uint16_t addr, uint8_t data);
     uint16_t read_word(uint16_t addr);
     void write_word(uint16_t addr, uint16_t data);
+    // a debugger's write: no access handlers, watchpoints or trace, but
+    // SP and SREG are kept in step
+    void poke(uint16_t addr, uint8_t data);
+
+    // the only compares on the way are against the low-water mark and for
+    // __brkval to follow; a watch on SP is checked by Instrumented
+    void set_sp(uint16_t value)
+    {
+        sp = value;
+        sram.bytes[AVR_REG_SPL] = value & 0xff;
+        sram.bytes[AVR_REG_SPH] = value >> 8;
+        dirty[0] = 1;
+        if(value < stack_low || 0 <= stack_brkval)
+        {
+            stack_check(value);
+        }
+    }
 
     uint8_t pop_byte();
     void push_byte(uint8_t data);
     uint16_t pop_word();
     void push_word(uint16_t data);
 
+    // called after every control-flow instruction, taken or not, and on
+    // interrupt entry; compiled out unless built with AVRE_COVERAGE
+    void edge()
+    {
+#ifdef AVRE_COVERAGE
+        uint16_t cur = Coverage::location(pc);
+        coverage_map[cur ^ coverage_prev]++;
+        coverage_prev = cur >> 1;
+#endif
+    }
+
+    // called by CALL, RCALL, ICALL and interrupt entry once the return
+    // address is pushed, and by RET and RETI once it is popped; IJMP counts
+    // as a return too, since that is how pop/pop/ijmp sequences return.
+    // Nothing here, Instrumented hides them for the call graph
+    void called(uint16_t target, bool irq)
+    {
+    }
+
+    void returned()
+    {
+    }
+
+    // called by CP, CPC, CPI and CPSE before pc moves on; compiled out
+    // unless built with AVRE_CMPLOG
+    void compare(uint16_t d, uint8_t a, uint8_t b, bool carry)
+    {
+#ifdef AVRE_CMPLOG
+        CmpLogEntry *e;
+        uint16_t at = pc - 1;
+
+        e = &cmplog->entries[(cmplog->head - 1) % CMPLOG_ENTRIES];
+        if(carry && cmplog->head != 0 && (uint16_t)(at - cmplog_pc) <= 2 && d == cmplog_reg + 1u && e->size < 4)
+        {
+            e->a |= (uint32_t)a << (e->size << 3);
+            e->b |= (uint32_t)b << (e->size << 3);
+            e->size++;
+        }
+        else
+        {
+            e = &cmplog->entries[cmplog->head % CMPLOG_ENTRIES];
+            e->pc = at;
+            e->size = 1;
+            e->reg = d;
+            e->a = a;
+            e->b = b;
+            cmplog->head++;
+        }
+        cmplog_pc = at;
+        cmplog_reg = d;
+#endif
+    }
+
+    // hook points of step(); nothing here, Engine<Hooks> and Instrumented
+    // hide them
+    void before_exec(uint16_t at)
+    {
+    }
+
+    void after_exec(uint16_t at, int taken)
+    {
+    }
+
+    void before_irq(int num)
+    {
+    }
+
     void unimplemented(const char *s);
     void illegalinst(uint16_t inst);
 };
@@ -0,0 +1,252 @@
+// backend.cc
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "backend.hh"
+#include "metrics.hh"
+
+static int open_unix(const char *path)
+{
+    struct sockaddr_un addr;
+    int fd;
+
+    if(sizeof(addr.sun_path) <= strlen(path))
+    {
+        fprintf(stderr, "%s: socket path too long\n", path);
+        exit(1);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror(path);
+        exit(1);
+    }
+    return fd;
+}
+
+static int open_tcp(const char *spec)
+{
+    struct addrinfo hints, *res, *ai;
+    std::string host(spec);
+    size_t colon;
+    int fd = -1;
+
+    colon = host.rfind(':');
+    if(colon == std::string::npos)
+    {
+        fprintf(stderr, "%s: expected host:port\n", spec);
+        exit(1);
+    }
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if(getaddrinfo(host.substr(0, colon).c_str(), host.c_str() + colon + 1, &hints, &res) != 0)
+    {
+        fprintf(stderr, "%s: cannot resolve address\n", spec);
+        exit(1);
+    }
+    for(ai = res; ai != NULL; ai = ai->ai_next)
+    {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if(fd < 0)
+        {
+            continue;
+        }
+        if(connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+        {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if(fd < 0)
+    {
+        perror(spec);
+        exit(1);
+    }
+    return fd;
+}
+
+static int open_spec(const char *spec, int flags)
+{
+    int fd;
+
+    if(strncmp(spec, "fd:", 3) == 0)
+    {
+        return atoi(spec + 3);
+    }
+    if(strncmp(spec, "file:", 5) == 0)
+    {
+        fd = open(spec + 5, flags, 0644);
+        if(fd < 0)
+        {
+            perror(spec + 5);
+            exit(1);
+        }
+        return fd;
+    }
+    if(strncmp(spec, "unix:", 5) == 0)
+    {
+        return open_unix(spec + 5);
+    }
+    if(strncmp(spec, "tcp:", 4) == 0)
+    {
+        return open_tcp(spec + 4);
+    }
+    fprintf(stderr, "unknown backend -- '%s'\n", spec);
+    exit(1);
+}
+
+Backend::Backend()
+{
+}
+
+Backend::~Backend()
+{
+}
+
+Backend *Backend::open(const char *rx, const char *tx)
+{
+    int ifd, ofd;
+
+    if(strcmp(rx, "null") == 0 && strcmp(tx, "null") == 0)
+    {
+        return new NullBackend();
+    }
+    ifd = open_spec(rx, O_RDONLY);
+    // a socket named for both directions is connected only once
+    if(strcmp(rx, tx) == 0 && strncmp(rx, "fd:", 3) != 0 && strncmp(rx, "file:", 5) != 0)
+    {
+        ofd = ifd;
+    }
+    else
+    {
+        ofd = open_spec(tx, O_WRONLY | O_CREAT | O_TRUNC);
+    }
+    return new FdBackend(ifd, ofd, strncmp(rx, "fd:", 3) != 0, strncmp(tx, "fd:", 3) != 0);
+}
+
+FdBackend::FdBackend(int _ifd, int _ofd, bool _close_ifd, bool _close_ofd)
+    : Backend(), ifd(_ifd), ofd(_ofd), close_ifd(_close_ifd), close_ofd(_close_ofd)
+{
+}
+
+FdBackend::~FdBackend()
+{
+    if(close_ifd)
+    {
+        close(ifd);
+    }
+    // a shared socket is closed once
+    if(close_ofd && !(close_ifd && ofd == ifd))
+    {
+        close(ofd);
+    }
+}
+
+int FdBackend::poll_read(uint8_t *data)
+{
+    fd_set readfds;
+    struct timeval tv = {0, 0};
+
+    FD_ZERO(&readfds);
+    FD_SET(ifd, &readfds);
+
+    Metrics::count(Metrics::local()->syscalls);
+    if(0 < select(ifd + 1, &readfds, NULL, NULL, &tv))
+    {
+        Metrics::count(Metrics::local()->syscalls);
+        return read(ifd, data, 1) == 1;
+    }
+    return 0;
+}
+
+int FdBackend::poll_write(uint8_t data)
+{
+    fd_set writefds;
+    struct timeval tv = {0, 0};
+
+    FD_ZERO(&writefds);
+    FD_SET(ofd, &writefds);
+
+    Metrics::count(Metrics::local()->syscalls);
+    if(0 < select(ofd + 1, NULL, &writefds, NULL, &tv))
+    {
+        Metrics::count(Metrics::local()->syscalls);
+        return write(ofd, &data, 1) == 1;
+    }
+    return 0;
+}
+
+NullBackend::NullBackend()
+    : Backend()
+{
+}
+
+NullBackend::~NullBackend()
+{
+}
+
+int NullBackend::poll_read(uint8_t *data)
+{
+    return 0;
+}
+
+int NullBackend::poll_write(uint8_t data)
+{
+    return 1;
+}
+
+MemoryBackend::MemoryBackend()
+    : Backend(), input(NULL), input_size(0), input_pos(0)
+{
+}
+
+MemoryBackend::~MemoryBackend()
+{
+}
+
+void MemoryBackend::feed(const uint8_t *data, size_t size)
+{
+    input = data;
+    input_size = size;
+    input_pos = 0;
+}
+
+bool MemoryBackend::drained() const
+{
+    return input_pos == input_size;
+}
+
+int MemoryBackend::poll_read(uint8_t *data)
+{
+    if(input_pos < input_size)
+    {
+        *data = input[input_pos++];
+        return 1;
+    }
+    return 0;
+}
+
+int MemoryBackend::poll_write(uint8_t data)
+{
+    output.push_back(data);
+    return 1;
+}
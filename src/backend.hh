@@ -0,0 +1,70 @@
+// backend.hh
+
+#ifndef AVRE_BACKEND_HH
+#define AVRE_BACKEND_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Backend
+{
+public:
+    Backend();
+    virtual ~Backend();
+
+    // both return 1 when a byte was transferred, 0 otherwise
+    virtual int poll_read(uint8_t *data) = 0;
+    virtual int poll_write(uint8_t data) = 0;
+
+    // a NullBackend when both are null
+    static Backend *open(const char *rx, const char *tx);
+};
+
+class FdBackend : public Backend
+{
+protected:
+    int ifd, ofd;
+    // the descriptors opened for it, rather than inherited as fd:N
+    bool close_ifd, close_ofd;
+
+public:
+    FdBackend(int _ifd, int _ofd, bool _close_ifd, bool _close_ofd);
+    virtual ~FdBackend();
+
+    virtual int poll_read(uint8_t *data);
+    virtual int poll_write(uint8_t data);
+};
+
+// never has input and drops whatever is written
+class NullBackend : public Backend
+{
+public:
+    NullBackend();
+    virtual ~NullBackend();
+
+    virtual int poll_read(uint8_t *data);
+    virtual int poll_write(uint8_t data);
+};
+
+// reads from a caller-owned buffer and collects what is written
+class MemoryBackend : public Backend
+{
+protected:
+    const uint8_t *input;
+    size_t input_size, input_pos;
+
+public:
+    std::vector<uint8_t> output;
+
+    MemoryBackend();
+    virtual ~MemoryBackend();
+
+    void feed(const uint8_t *data, size_t size);
+    bool drained() const;
+
+    virtual int poll_read(uint8_t *data);
+    virtual int poll_write(uint8_t data);
+};
+
+#endif
@@ -0,0 +1,180 @@
+// callgraph.cc
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "callgraph.hh"
+
+#define CALLGRAPH_ROOT (0xffffffffu)
+
+CallGraph::CallGraph()
+    : last(0)
+{
+    CallNode root = {0, 0, false, 1, 0};
+
+    nodes.push_back(root);
+}
+
+uint32_t CallGraph::current() const
+{
+    return stack.empty() ? 0 : stack.back().node;
+}
+
+void CallGraph::charge(uint64_t cycle)
+{
+    nodes[current()].self += cycle - last;
+    last = cycle;
+}
+
+void CallGraph::unwind(uint16_t sp)
+{
+    // a frame is gone once its return address lies above the stack pointer
+    while(!stack.empty() && stack.back().sp < sp)
+    {
+        stack.pop_back();
+    }
+}
+
+void CallGraph::call(uint16_t target, uint16_t sp, uint64_t cycle, bool irq)
+{
+    std::unordered_map<uint64_t, uint32_t>::iterator it;
+    CallFrame frame;
+    uint64_t key;
+
+    charge(cycle);
+    unwind(sp + 2);
+
+    frame.node = current();
+    frame.sp = sp;
+    if(stack.size() < CALLGRAPH_DEPTH)
+    {
+        key = (uint64_t)frame.node << 17 | (uint64_t)irq << 16 | target;
+        it = children.find(key);
+        if(it == children.end())
+        {
+            CallNode node = {frame.node, target, irq, 0, 0};
+            it = children.insert(std::make_pair(key, (uint32_t)nodes.size())).first;
+            nodes.push_back(node);
+        }
+        frame.node = it->second;
+    }
+    nodes[frame.node].calls++;
+    stack.push_back(frame);
+}
+
+void CallGraph::ret(uint16_t sp, uint64_t cycle)
+{
+    charge(cycle);
+    unwind(sp);
+}
+
+std::string CallGraph::name(const CallNode &node, const Symbols &symbols) const
+{
+    const Symbol *symbol;
+    char buf[32];
+
+    if(&node == &nodes[0])
+    {
+        return "reset";
+    }
+    if(node.irq)
+    {
+        snprintf(buf, sizeof(buf), "irq%u", node.target);
+        return buf;
+    }
+    symbol = symbols.find((uint32_t)node.target << 1);
+    if(symbol == NULL)
+    {
+        snprintf(buf, sizeof(buf), "0x%05x", (uint32_t)node.target << 1);
+        return buf;
+    }
+    if(symbol->addr != (uint32_t)node.target << 1)
+    {
+        snprintf(buf, sizeof(buf), "+0x%x", ((uint32_t)node.target << 1) - symbol->addr);
+        return symbol->name + buf;
+    }
+    return symbol->name;
+}
+
+std::string CallGraph::path(uint32_t index, const Symbols &symbols) const
+{
+    std::string out = name(nodes[index], symbols);
+
+    while(index != 0)
+    {
+        index = nodes[index].parent;
+        out = name(nodes[index], symbols) + ";" + out;
+    }
+    return out;
+}
+
+void CallGraph::collapsed(FILE *f, const Symbols &symbols, uint64_t cycle)
+{
+    charge(cycle);
+    for(uint32_t i = 0; i < nodes.size(); i++)
+    {
+        if(nodes[i].self != 0)
+        {
+            fprintf(f, "%s %llu\n", path(i, symbols).c_str(), (unsigned long long)nodes[i].self);
+        }
+    }
+}
+
+void CallGraph::edges(FILE *f, const Symbols &symbols, uint64_t cycle)
+{
+    struct Edge
+    {
+        uint32_t caller, callee;
+        uint64_t calls, inclusive, exclusive;
+    };
+    std::map<std::pair<uint32_t, uint32_t>, Edge> edges;
+    std::vector<uint64_t> inclusive(nodes.size());
+    std::vector<Edge> sorted;
+    uint32_t caller, callee;
+
+    charge(cycle);
+    // children always come after their parent
+    for(uint32_t i = nodes.size(); i-- != 0; )
+    {
+        inclusive[i] += nodes[i].self;
+        if(i != 0)
+        {
+            inclusive[nodes[i].parent] += inclusive[i];
+        }
+    }
+
+    for(uint32_t i = 1; i < nodes.size(); i++)
+    {
+        const CallNode &parent = nodes[nodes[i].parent];
+        caller = nodes[i].parent == 0 ? CALLGRAPH_ROOT : (uint32_t)parent.irq << 16 | parent.target;
+        callee = (uint32_t)nodes[i].irq << 16 | nodes[i].target;
+        Edge &edge = edges[std::make_pair(caller, callee)];
+        if(edge.calls == 0)
+        {
+            edge.caller = nodes[i].parent;
+            edge.callee = i;
+        }
+        edge.calls += nodes[i].calls;
+        edge.inclusive += inclusive[i];
+        edge.exclusive += nodes[i].self;
+    }
+
+    for(const std::pair<const std::pair<uint32_t, uint32_t>, Edge> &edge : edges)
+    {
+        sorted.push_back(edge.second);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const Edge &a, const Edge &b)
+        {
+            return a.inclusive > b.inclusive;
+        });
+
+    fprintf(f, "%12s %14s %14s  %s\n", "calls", "inclusive", "exclusive", "caller -> callee");
+    for(const Edge &edge : sorted)
+    {
+        fprintf(f, "%12llu %14llu %14llu  %s -> %s\n", (unsigned long long)edge.calls,
+            (unsigned long long)edge.inclusive, (unsigned long long)edge.exclusive,
+            name(nodes[edge.caller], symbols).c_str(), name(nodes[edge.callee], symbols).c_str());
+    }
+}
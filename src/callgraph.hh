@@ -0,0 +1,69 @@
+// callgraph.hh
+
+#ifndef AVRE_CALLGRAPH_HH
+#define AVRE_CALLGRAPH_HH
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "symbols.hh"
+
+// deeper call chains are folded into their innermost frame
+#define CALLGRAPH_DEPTH (256u)
+
+struct CallNode
+{
+    uint32_t parent;
+    // word address called, or the vector number for an interrupt
+    uint16_t target;
+    bool irq;
+    uint64_t calls;
+    // cycles spent in this frame itself
+    uint64_t self;
+};
+
+struct CallFrame
+{
+    uint32_t node;
+    // SP after the return address was pushed
+    uint16_t sp;
+};
+
+// a shadow call stack kept in step with the guest's own: a frame is live
+// while its return address is still on the guest stack, so frames are
+// dropped by stack pointer instead of by matching RETs, which keeps the
+// shadow stack right across longjmp, pop/pop/ijmp returns and context
+// switches that abandon stacks
+class CallGraph
+{
+protected:
+    // the tree of call paths; node 0 is the code running since reset
+    std::vector<CallNode> nodes;
+    std::unordered_map<uint64_t, uint32_t> children;
+    std::vector<CallFrame> stack;
+    uint64_t last;
+
+    uint32_t current() const;
+    void charge(uint64_t cycle);
+    void unwind(uint16_t sp);
+    std::string name(const CallNode &node, const Symbols &symbols) const;
+    std::string path(uint32_t index, const Symbols &symbols) const;
+
+public:
+    CallGraph();
+
+    // sp is the stack pointer right after the push or pop
+    void call(uint16_t target, uint16_t sp, uint64_t cycle, bool irq);
+    void ret(uint16_t sp, uint64_t cycle);
+
+    // one "caller;...;callee cycles" line per call path, cycles spent in
+    // the innermost frame, as flame graph tools take them
+    void collapsed(FILE *f, const Symbols &symbols, uint64_t cycle);
+    // calls and inclusive and exclusive cycles per caller/callee pair
+    void edges(FILE *f, const Symbols &symbols, uint64_t cycle);
+};
+
+#endif
@@ -0,0 +1,46 @@
+// cmplog.cc
+
+#include <cstdlib>
+
+#include <sys/shm.h>
+
+#include "cmplog.hh"
+
+static CmpLogRing *attach()
+{
+    static CmpLogRing local;
+    const char *id;
+    void *p;
+
+    id = getenv("AVRE_CMPLOG_SHM_ID");
+    if(id == NULL)
+    {
+        return &local;
+    }
+    p = shmat(atoi(id), NULL, 0);
+    if(p == (void *)-1)
+    {
+        perror("shmat");
+        exit(1);
+    }
+    return (CmpLogRing *)p;
+}
+
+CmpLogRing *CmpLog::ring()
+{
+    static CmpLogRing *log = attach();
+    return log;
+}
+
+void CmpLog::dump(FILE *f)
+{
+    CmpLogRing *log = ring();
+    uint32_t i;
+
+    i = log->head < CMPLOG_ENTRIES ? 0 : log->head - CMPLOG_ENTRIES;
+    for(; i != log->head; i++)
+    {
+        CmpLogEntry &e = log->entries[i % CMPLOG_ENTRIES];
+        fprintf(f, "%05x r%-2u %u %0*x %0*x\n", (uint32_t)e.pc << 1, e.reg, e.size * 8, e.size * 2, e.a, e.size * 2, e.b);
+    }
+}
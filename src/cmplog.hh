@@ -0,0 +1,39 @@
+// cmplog.hh
+
+#ifndef AVRE_CMPLOG_HH
+#define AVRE_CMPLOG_HH
+
+#include <cstdint>
+#include <cstdio>
+
+#define CMPLOG_ENTRIES (1024u)
+
+// one comparison; a CPC that continues a compare on the next register
+// within two words widens the previous entry instead of adding one, so
+// a CP/CPC/CPC/CPC chain shows up as a single 32-bit entry
+struct CmpLogEntry
+{
+    uint16_t pc;    // word address of the first instruction
+    uint8_t size;   // operand width in bytes, 1 to 4
+    uint8_t reg;    // register holding the low byte of the left operand
+    uint32_t a, b;
+};
+
+// entries[head % CMPLOG_ENTRIES] is written next; head only grows
+struct CmpLogRing
+{
+    uint32_t head;
+    uint32_t reserved;
+    struct CmpLogEntry entries[CMPLOG_ENTRIES];
+};
+
+// the ring lives in the shared memory segment named by AVRE_CMPLOG_SHM_ID
+// when set, in a private buffer otherwise
+class CmpLog
+{
+public:
+    static CmpLogRing *ring();
+    static void dump(FILE *f);
+};
+
+#endif
@@ -0,0 +1,398 @@
+// condition.cc
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "condition.hh"
+
+enum
+{
+    OP_CONST,   // value
+    OP_BYTE,    // data address
+    OP_WORD,    // data address
+    OP_FLAG,    // SREG bit
+    OP_SP,
+    OP_PC,
+    OP_HITS,
+    OP_LOAD,
+    OP_LOADW,
+    OP_NOT,
+    OP_INV,
+    OP_NEG,
+    OP_LOR,
+    OP_LAND,
+    OP_OR,
+    OP_XOR,
+    OP_AND,
+    OP_EQ,
+    OP_NE,
+    OP_LT,
+    OP_LE,
+    OP_GT,
+    OP_GE,
+    OP_SHL,
+    OP_SHR,
+    OP_ADD,
+    OP_SUB,
+};
+
+struct Binary
+{
+    const char *op;
+    int prec;
+    int32_t code;
+};
+
+// two-character operators first, so they are not taken for their prefix
+static const Binary binaries[] = {
+    {"||", 1, OP_LOR},
+    {"&&", 2, OP_LAND},
+    {"==", 6, OP_EQ},
+    {"!=", 6, OP_NE},
+    {"<=", 7, OP_LE},
+    {">=", 7, OP_GE},
+    {"<<", 8, OP_SHL},
+    {">>", 8, OP_SHR},
+    {"|", 3, OP_OR},
+    {"^", 4, OP_XOR},
+    {"&", 5, OP_AND},
+    {"<", 7, OP_LT},
+    {">", 7, OP_GT},
+    {"+", 9, OP_ADD},
+    {"-", 9, OP_SUB},
+};
+
+static const char flags[] = "CZNVSHTI";
+
+// recursive descent over the text, with precedence climbing for the
+// binary operators; keeps track of the stack depth the code will need
+class Parser
+{
+protected:
+    const char *p;
+    unsigned depth;
+
+    void skip()
+    {
+        while(isspace((unsigned char)*p))
+        {
+            p++;
+        }
+    }
+
+    bool accept(const char *s)
+    {
+        skip();
+        if(strncmp(p, s, strlen(s)) != 0)
+        {
+            return false;
+        }
+        p += strlen(s);
+        return true;
+    }
+
+    void push(int32_t op)
+    {
+        code.push_back(op);
+        if(CONDITION_STACK < ++depth)
+        {
+            fail("too deeply nested");
+        }
+    }
+
+    void push(int32_t op, int32_t value)
+    {
+        push(op);
+        code.push_back(value);
+    }
+
+    void fail(const char *what)
+    {
+        if(error.empty())
+        {
+            error = what;
+        }
+    }
+
+    void primary();
+    void unary();
+    void binary(int prec);
+
+public:
+    std::vector<int32_t> code;
+    std::string error;
+
+    Parser(const char *expr)
+        : p(expr), depth(0)
+    {
+        binary(1);
+        skip();
+        if(*p != 0)
+        {
+            fail("unexpected text");
+        }
+    }
+
+    const char *rest() const
+    {
+        return p;
+    }
+};
+
+void Parser::primary()
+{
+    std::string name;
+    const char *flag;
+    bool word = false;
+    char *end;
+    long n;
+
+    skip();
+    if(isdigit((unsigned char)*p))
+    {
+        push(OP_CONST, strtol(p, &end, 0));
+        p = end;
+        return;
+    }
+    if(accept("("))
+    {
+        binary(1);
+        if(!accept(")"))
+        {
+            fail("missing )");
+        }
+        return;
+    }
+    if(accept("w["))
+    {
+        word = true;
+    }
+    if(word || accept("["))
+    {
+        binary(1);
+        if(!accept("]"))
+        {
+            fail("missing ]");
+        }
+        code.push_back(word ? OP_LOADW : OP_LOAD);
+        return;
+    }
+
+    while(isalnum((unsigned char)*p) || *p == '_' || *p == '.')
+    {
+        name += toupper((unsigned char)*p++);
+    }
+    if(name.size() >= 2 && name[0] == 'R' && isdigit((unsigned char)name[1]))
+    {
+        n = strtol(name.c_str() + 1, &end, 10);
+        if(*end == 0 && n < 32)
+        {
+            push(OP_BYTE, n);
+            return;
+        }
+    }
+    if(name == "X" || name == "Y" || name == "Z")
+    {
+        push(OP_WORD, name == "X" ? AVR_REG_X : name == "Y" ? AVR_REG_Y : AVR_REG_Z);
+    }
+    else if(name == "SREG")
+    {
+        push(OP_BYTE, AVR_REG_SREG);
+    }
+    else if(name.size() == 6 && name.compare(0, 5, "SREG.") == 0 && (flag = strchr(flags, name[5])) != NULL)
+    {
+        push(OP_FLAG, flag - flags);
+    }
+    else if(name == "SP")
+    {
+        push(OP_SP);
+    }
+    else if(name == "PC")
+    {
+        push(OP_PC);
+    }
+    else if(name == "HITS")
+    {
+        push(OP_HITS);
+    }
+    else
+    {
+        fail(name.empty() ? "expected an operand" : "unknown name");
+        // something for the rest to work on
+        push(OP_CONST, 0);
+    }
+}
+
+void Parser::unary()
+{
+    if(accept("!"))
+    {
+        unary();
+        code.push_back(OP_NOT);
+    }
+    else if(accept("~"))
+    {
+        unary();
+        code.push_back(OP_INV);
+    }
+    else if(accept("-"))
+    {
+        unary();
+        code.push_back(OP_NEG);
+    }
+    else
+    {
+        primary();
+    }
+}
+
+void Parser::binary(int prec)
+{
+    const Binary *op;
+
+    unary();
+    while(error.empty())
+    {
+        op = NULL;
+        skip();
+        for(const Binary &b : binaries)
+        {
+            if(strncmp(p, b.op, strlen(b.op)) == 0)
+            {
+                op = &b;
+                break;
+            }
+        }
+        if(op == NULL || op->prec < prec)
+        {
+            return;
+        }
+        p += strlen(op->op);
+        binary(op->prec + 1);
+        code.push_back(op->code);
+        depth--;
+    }
+}
+
+Condition *Condition::compile(const char *expr, std::string &error)
+{
+    Parser parser(expr);
+    Condition *condition;
+
+    if(!parser.error.empty())
+    {
+        error = parser.error + (*parser.rest() == 0 ? std::string(" at the end") : " at '" + std::string(parser.rest()).substr(0, 16) + "'");
+        return NULL;
+    }
+    condition = new Condition();
+    condition->code = parser.code;
+    condition->text = expr;
+    condition->hits = 0;
+    return condition;
+}
+
+bool Condition::test(const AVR *avr) const
+{
+    int32_t stack[CONDITION_STACK + 1], *top = stack;
+    uint16_t addr;
+
+    // the parser made sure the stack is deep enough and every binary
+    // operator has two operands
+    for(size_t i = 0; i < code.size(); i++)
+    {
+        switch(code[i])
+        {
+        case OP_CONST:
+            *++top = code[++i];
+            break;
+        case OP_BYTE:
+            *++top = avr->sram.bytes[code[++i]];
+            break;
+        case OP_WORD:
+            addr = code[++i];
+            *++top = avr->sram.bytes[addr] | avr->sram.bytes[addr + 1] << 8;
+            break;
+        case OP_FLAG:
+            *++top = (avr->sram.bytes[AVR_REG_SREG] >> code[++i]) & 1;
+            break;
+        case OP_SP:
+            *++top = avr->sp;
+            break;
+        case OP_PC:
+            *++top = (int32_t)avr->pc << 1;
+            break;
+        case OP_HITS:
+            *++top = (int32_t)hits;
+            break;
+        case OP_LOAD:
+            *top = avr->sram.bytes[(uint16_t)*top];
+            break;
+        case OP_LOADW:
+            addr = *top;
+            *top = avr->sram.bytes[addr] | avr->sram.bytes[(uint16_t)(addr + 1)] << 8;
+            break;
+        case OP_NOT:
+            *top = !*top;
+            break;
+        case OP_INV:
+            *top = ~*top;
+            break;
+        case OP_NEG:
+            *top = -(uint32_t)*top;
+            break;
+        default:
+            top--;
+            switch(code[i])
+            {
+            case OP_LOR:
+                *top = *top || top[1];
+                break;
+            case OP_LAND:
+                *top = *top && top[1];
+                break;
+            case OP_OR:
+                *top |= top[1];
+                break;
+            case OP_XOR:
+                *top ^= top[1];
+                break;
+            case OP_AND:
+                *top &= top[1];
+                break;
+            case OP_EQ:
+                *top = *top == top[1];
+                break;
+            case OP_NE:
+                *top = *top != top[1];
+                break;
+            case OP_LT:
+                *top = *top < top[1];
+                break;
+            case OP_LE:
+                *top = *top <= top[1];
+                break;
+            case OP_GT:
+                *top = *top > top[1];
+                break;
+            case OP_GE:
+                *top = *top >= top[1];
+                break;
+            case OP_SHL:
+                *top = (uint32_t)*top << (top[1] & 31);
+                break;
+            case OP_SHR:
+                *top = *top >> (top[1] & 31);
+                break;
+            case OP_ADD:
+                *top = (uint32_t)*top + (uint32_t)top[1];
+                break;
+            case OP_SUB:
+                *top = (uint32_t)*top - (uint32_t)top[1];
+                break;
+            }
+            break;
+        }
+    }
+    return *top != 0;
+}
@@ -0,0 +1,51 @@
+// condition.hh
+
+#ifndef AVRE_CONDITION_HH
+#define AVRE_CONDITION_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "avr.hh"
+
+// the deepest evaluation stack a condition may need
+#define CONDITION_STACK (16u)
+
+// a breakpoint condition, such as
+//
+//     r24 == 0x42 && [0x0123] != 0
+//     hits >= 100 && SREG.Z
+//
+// parsed once into bytecode for a small stack machine and evaluated only
+// when the pc gets to the breakpoint. Operands are numbers, r0 to r31,
+// the pointers X, Y and Z, SP, PC (a byte address), SREG and its flags as
+// SREG.C to SREG.I, [addr] and w[addr] for a data byte and little-endian
+// word (read as they are, without access handlers), and hits, the times
+// the breakpoint has been reached, this one included. The operators are
+// C's ! ~ - unary, + -, << >>, < <= > >=, == !=, &, ^, |, && and ||, on
+// 32-bit signed values
+class Condition
+{
+protected:
+    // opcodes, some followed by an operand
+    std::vector<int32_t> code;
+
+public:
+    std::string text;
+    uint64_t hits;
+
+    // NULL, with error set, if expr does not parse
+    static Condition *compile(const char *expr, std::string &error);
+
+    // counts a hit and tests the condition
+    bool hit(const AVR *avr)
+    {
+        hits++;
+        return test(avr);
+    }
+
+    bool test(const AVR *avr) const;
+};
+
+#endif
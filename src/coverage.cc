@@ -0,0 +1,34 @@
+// coverage.cc
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <sys/shm.h>
+
+#include "coverage.hh"
+
+static uint8_t *attach()
+{
+    static uint8_t local[COVERAGE_MAP_SIZE];
+    const char *id;
+    void *p;
+
+    id = getenv("__AFL_SHM_ID");
+    if(id == NULL)
+    {
+        return local;
+    }
+    p = shmat(atoi(id), NULL, 0);
+    if(p == (void *)-1)
+    {
+        perror("shmat");
+        exit(1);
+    }
+    return (uint8_t *)p;
+}
+
+uint8_t *Coverage::map()
+{
+    static uint8_t *bitmap = attach();
+    return bitmap;
+}
@@ -0,0 +1,24 @@
+// coverage.hh
+
+#ifndef AVRE_COVERAGE_HH
+#define AVRE_COVERAGE_HH
+
+#include <cstdint>
+
+#define COVERAGE_MAP_SIZE (0x10000u)
+
+// the AFL edge map: the shared memory segment named by __AFL_SHM_ID when
+// run under a fuzzer, a private buffer otherwise
+class Coverage
+{
+public:
+    static uint8_t *map();
+
+    // odd multiplier, so distinct word addresses get distinct locations
+    static uint16_t location(uint16_t pc)
+    {
+        return pc * 40503u;
+    }
+};
+
+#endif
@@ -0,0 +1,464 @@
+// decoder.cc
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "avr.hh"
+#include "decoder.hh"
+
+// where an operand, or the index into a row's aliases, comes from in the
+// instruction word
+enum
+{
+    FIELD_NONE,
+    FIELD_D5,       // Rd, r0 to r31
+    FIELD_R5,       // Rr, r0 to r31
+    FIELD_D4,       // Rd, r16 to r31
+    FIELD_R4,       // Rr, r16 to r31
+    FIELD_D3,       // Rd, r16 to r23
+    FIELD_R3,       // Rr, r16 to r23
+    FIELD_DW,       // MOVW's even Rd
+    FIELD_RW,       // MOVW's even Rr
+    FIELD_DI,       // ADIW and SBIW's r24 to r30
+    FIELD_K4,
+    FIELD_K6,
+    FIELD_K8,
+    FIELD_K16,      // the data address word
+    FIELD_K22,      // the word address of JMP and CALL
+    FIELD_K7,       // branch offset
+    FIELD_K12,      // RJMP and RCALL offset
+    FIELD_A5,
+    FIELD_A6,
+    FIELD_B3,
+    FIELD_X,
+    FIELD_XP,
+    FIELD_MX,
+    FIELD_YP,
+    FIELD_MY,
+    FIELD_Z,
+    FIELD_ZP,
+    FIELD_MZ,
+    FIELD_YQ,
+    FIELD_ZQ,
+    FIELD_S3,       // SREG bit of BRBS and BRBC
+    FIELD_S4,       // SREG bit of BSET and BCLR
+    FIELD_Q,        // 1 for LDD and STD with a displacement, 0 for LD and ST
+};
+
+struct Syntax
+{
+    // the opcode it is for
+    const char *name;
+    const char *mnemonic;
+    // the mnemonic is aliases[alias field] instead when set
+    const char *const *aliases;
+    uint8_t alias;
+    uint8_t fields[2];
+};
+
+static const char *const branch_set[] = {"brcs", "breq", "brmi", "brvs", "brlt", "brhs", "brts", "brie"};
+static const char *const branch_clear[] = {"brcc", "brne", "brpl", "brvc", "brge", "brhc", "brtc", "brid"};
+static const char *const flag_set[] = {"sec", "sez", "sen", "sev", "ses", "seh", "set", "sei"};
+static const char *const flag_clear[] = {"clc", "clz", "cln", "clv", "cls", "clh", "clt", "cli"};
+static const char *const loads[] = {"ld", "ldd"};
+static const char *const stores[] = {"st", "std"};
+
+static const char *const pointer_names[] = {"X", "X+", "-X", "Y+", "-Y", "Z", "Z+", "-Z"};
+
+// in the order of opcodes
+static const Syntax syntaxes[OPCODE_COUNT] = {
+    {"ADC", "adc", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"ADD", "add", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"ADIW", "adiw", NULL, 0, {FIELD_DI, FIELD_K6}},
+    {"AND", "and", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"ANDI", "andi", NULL, 0, {FIELD_D4, FIELD_K8}},
+    {"ASR", "asr", NULL, 0, {FIELD_D5}},
+    {"BCLR", NULL, flag_clear, FIELD_S4, {}},
+    {"BLD", "bld", NULL, 0, {FIELD_D5, FIELD_B3}},
+    {"BRBC", NULL, branch_clear, FIELD_S3, {FIELD_K7}},
+    {"BRBS", NULL, branch_set, FIELD_S3, {FIELD_K7}},
+    {"BREAK", "break", NULL, 0, {}},
+    {"BSET", NULL, flag_set, FIELD_S4, {}},
+    {"BST", "bst", NULL, 0, {FIELD_D5, FIELD_B3}},
+    {"CALL", "call", NULL, 0, {FIELD_K22}},
+    {"CBI", "cbi", NULL, 0, {FIELD_A5, FIELD_B3}},
+    {"COM", "com", NULL, 0, {FIELD_D5}},
+    {"CP", "cp", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"CPC", "cpc", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"CPI", "cpi", NULL, 0, {FIELD_D4, FIELD_K8}},
+    {"CPSE", "cpse", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"DEC", "dec", NULL, 0, {FIELD_D5}},
+    {"DES", "des", NULL, 0, {FIELD_K4}},
+    {"EICALL", "eicall", NULL, 0, {}},
+    {"EIJMP", "eijmp", NULL, 0, {}},
+    {"ELPM_1", "elpm", NULL, 0, {}},
+    {"ELPM_2", "elpm", NULL, 0, {FIELD_D5, FIELD_Z}},
+    {"ELPM_3", "elpm", NULL, 0, {FIELD_D5, FIELD_ZP}},
+    {"EOR", "eor", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"FMUL", "fmul", NULL, 0, {FIELD_D3, FIELD_R3}},
+    {"FMULS", "fmuls", NULL, 0, {FIELD_D3, FIELD_R3}},
+    {"FMULSU", "fmulsu", NULL, 0, {FIELD_D3, FIELD_R3}},
+    {"ICALL", "icall", NULL, 0, {}},
+    {"IJMP", "ijmp", NULL, 0, {}},
+    {"IN", "in", NULL, 0, {FIELD_D5, FIELD_A6}},
+    {"INC", "inc", NULL, 0, {FIELD_D5}},
+    {"JMP", "jmp", NULL, 0, {FIELD_K22}},
+    {"LDI", "ldi", NULL, 0, {FIELD_D4, FIELD_K8}},
+    {"LDS", "lds", NULL, 0, {FIELD_D5, FIELD_K16}},
+    {"LD_X1", "ld", NULL, 0, {FIELD_D5, FIELD_X}},
+    {"LD_X2", "ld", NULL, 0, {FIELD_D5, FIELD_XP}},
+    {"LD_X3", "ld", NULL, 0, {FIELD_D5, FIELD_MX}},
+    {"LD_Y2", "ld", NULL, 0, {FIELD_D5, FIELD_YP}},
+    {"LD_Y3", "ld", NULL, 0, {FIELD_D5, FIELD_MY}},
+    {"LD_Y4", NULL, loads, FIELD_Q, {FIELD_D5, FIELD_YQ}},
+    {"LD_Z2", "ld", NULL, 0, {FIELD_D5, FIELD_ZP}},
+    {"LD_Z3", "ld", NULL, 0, {FIELD_D5, FIELD_MZ}},
+    {"LD_Z4", NULL, loads, FIELD_Q, {FIELD_D5, FIELD_ZQ}},
+    {"LPM_1", "lpm", NULL, 0, {}},
+    {"LPM_2", "lpm", NULL, 0, {FIELD_D5, FIELD_Z}},
+    {"LPM_3", "lpm", NULL, 0, {FIELD_D5, FIELD_ZP}},
+    {"LSR", "lsr", NULL, 0, {FIELD_D5}},
+    {"MOV", "mov", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"MOVW", "movw", NULL, 0, {FIELD_DW, FIELD_RW}},
+    {"MUL", "mul", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"MULS", "muls", NULL, 0, {FIELD_D4, FIELD_R4}},
+    {"MULSU", "mulsu", NULL, 0, {FIELD_D3, FIELD_R3}},
+    {"NEG", "neg", NULL, 0, {FIELD_D5}},
+    {"NOP", "nop", NULL, 0, {}},
+    {"OR", "or", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"ORI", "ori", NULL, 0, {FIELD_D4, FIELD_K8}},
+    {"OUT", "out", NULL, 0, {FIELD_A6, FIELD_D5}},
+    {"POP", "pop", NULL, 0, {FIELD_D5}},
+    {"PUSH", "push", NULL, 0, {FIELD_D5}},
+    {"RCALL", "rcall", NULL, 0, {FIELD_K12}},
+    {"RET", "ret", NULL, 0, {}},
+    {"RETI", "reti", NULL, 0, {}},
+    {"RJMP", "rjmp", NULL, 0, {FIELD_K12}},
+    {"ROR", "ror", NULL, 0, {FIELD_D5}},
+    {"SBC", "sbc", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"SBCI", "sbci", NULL, 0, {FIELD_D4, FIELD_K8}},
+    {"SBI", "sbi", NULL, 0, {FIELD_A5, FIELD_B3}},
+    {"SBIC", "sbic", NULL, 0, {FIELD_A5, FIELD_B3}},
+    {"SBIS", "sbis", NULL, 0, {FIELD_A5, FIELD_B3}},
+    {"SBIW", "sbiw", NULL, 0, {FIELD_DI, FIELD_K6}},
+    {"SBRC", "sbrc", NULL, 0, {FIELD_D5, FIELD_B3}},
+    {"SBRS", "sbrs", NULL, 0, {FIELD_D5, FIELD_B3}},
+    {"SLEEP", "sleep", NULL, 0, {}},
+    {"SPM2_1", "spm", NULL, 0, {}},
+    {"SPM2_2", "spm", NULL, 0, {FIELD_ZP}},
+    {"STS", "sts", NULL, 0, {FIELD_K16, FIELD_D5}},
+    {"ST_X1", "st", NULL, 0, {FIELD_X, FIELD_D5}},
+    {"ST_X2", "st", NULL, 0, {FIELD_XP, FIELD_D5}},
+    {"ST_X3", "st", NULL, 0, {FIELD_MX, FIELD_D5}},
+    {"ST_Y2", "st", NULL, 0, {FIELD_YP, FIELD_D5}},
+    {"ST_Y3", "st", NULL, 0, {FIELD_MY, FIELD_D5}},
+    {"ST_Y4", NULL, stores, FIELD_Q, {FIELD_YQ, FIELD_D5}},
+    {"ST_Z2", "st", NULL, 0, {FIELD_ZP, FIELD_D5}},
+    {"ST_Z3", "st", NULL, 0, {FIELD_MZ, FIELD_D5}},
+    {"ST_Z4", NULL, stores, FIELD_Q, {FIELD_ZQ, FIELD_D5}},
+    {"SUB", "sub", NULL, 0, {FIELD_D5, FIELD_R5}},
+    {"SUBI", "subi", NULL, 0, {FIELD_D4, FIELD_K8}},
+    {"SWAP", "swap", NULL, 0, {FIELD_D5}},
+    {"WDR", "wdr", NULL, 0, {}},
+};
+
+// the rows are looked up by opcode index, so they have to line up
+static bool check_syntaxes()
+{
+    for(unsigned i = 0; i < OPCODE_COUNT; i++)
+    {
+        if(strcmp(syntaxes[i].name, opcodes[i].name) != 0)
+        {
+            fprintf(stderr, "decoder: no syntax for %s\n", opcodes[i].name);
+            exit(1);
+        }
+    }
+    return true;
+}
+
+static int32_t extract(uint8_t field, uint16_t inst, uint16_t next)
+{
+    switch(field)
+    {
+    case FIELD_D5:
+        return (inst >> 4) & 0x1f;
+    case FIELD_R5:
+        return (inst & 0x0f) | ((inst >> 5) & 0x10);
+    case FIELD_D4:
+        return 16 + ((inst >> 4) & 0x0f);
+    case FIELD_R4:
+        return 16 + (inst & 0x0f);
+    case FIELD_D3:
+        return 16 + ((inst >> 4) & 0x07);
+    case FIELD_R3:
+        return 16 + (inst & 0x07);
+    case FIELD_DW:
+        return ((inst >> 4) & 0x0f) << 1;
+    case FIELD_RW:
+        return (inst & 0x0f) << 1;
+    case FIELD_DI:
+        return 24 + (((inst >> 4) & 0x03) << 1);
+    case FIELD_K4:
+        return (inst >> 4) & 0x0f;
+    case FIELD_K6:
+        return (inst & 0x0f) | ((inst >> 2) & 0x30);
+    case FIELD_K8:
+        return (inst & 0x0f) | ((inst >> 4) & 0xf0);
+    case FIELD_K16:
+        return next;
+    case FIELD_K22:
+        return ((((inst >> 3) & 0x3e) | (inst & 1)) << 16 | next) << 1;
+    case FIELD_K7:
+        return ((int8_t)(inst >> 2) >> 1) * 2;
+    case FIELD_K12:
+        return ((int16_t)(inst << 4) >> 4) * 2;
+    case FIELD_A5:
+        return (inst >> 3) & 0x1f;
+    case FIELD_A6:
+        return (inst & 0x0f) | ((inst >> 5) & 0x30);
+    case FIELD_B3:
+    case FIELD_S3:
+        return inst & 0x07;
+    case FIELD_S4:
+        return (inst >> 4) & 0x07;
+    case FIELD_X:
+    case FIELD_XP:
+    case FIELD_MX:
+    case FIELD_YP:
+    case FIELD_MY:
+    case FIELD_Z:
+    case FIELD_ZP:
+    case FIELD_MZ:
+        return field - FIELD_X;
+    case FIELD_YQ:
+    case FIELD_ZQ:
+        return (inst & 0x07) | ((inst >> 7) & 0x18) | ((inst >> 8) & 0x20);
+    case FIELD_Q:
+        return extract(FIELD_YQ, inst, next) != 0;
+    }
+    return 0;
+}
+
+static uint8_t operand_kind(uint8_t field)
+{
+    if(field <= FIELD_DI)
+    {
+        return OPERAND_REG;
+    }
+    if(field <= FIELD_K8)
+    {
+        return OPERAND_IMM;
+    }
+    switch(field)
+    {
+    case FIELD_K16:
+        return OPERAND_DATA;
+    case FIELD_K22:
+        return OPERAND_CODE;
+    case FIELD_K7:
+    case FIELD_K12:
+        return OPERAND_REL;
+    case FIELD_A5:
+    case FIELD_A6:
+        return OPERAND_IO;
+    case FIELD_B3:
+        return OPERAND_BIT;
+    case FIELD_YQ:
+        return OPERAND_Y;
+    case FIELD_ZQ:
+        return OPERAND_Z;
+    }
+    return OPERAND_PTR;
+}
+
+void Instruction::decode(Instruction &out, uint32_t pc, uint16_t inst, uint16_t next)
+{
+    static bool checked = check_syntaxes();
+    const Opcode *op = Opcode::find(inst);
+    const Syntax *syntax;
+
+    out.pc = pc;
+    out.target = -1;
+    out.inst = inst;
+    out.next = next;
+    (void)checked;
+    if(op == NULL)
+    {
+        out.op = NULL;
+        out.mnemonic = ".word";
+        out.words = 1;
+        out.count = 1;
+        out.operands[0].kind = OPERAND_DATA;
+        out.operands[0].value = inst;
+        return;
+    }
+
+    syntax = &syntaxes[op - opcodes];
+    out.op = op;
+    out.mnemonic = syntax->aliases == NULL ? syntax->mnemonic : syntax->aliases[extract(syntax->alias, inst, next)];
+    out.words = out.op->words;
+    out.count = 0;
+    for(uint8_t field : syntax->fields)
+    {
+        if(field == FIELD_NONE)
+        {
+            break;
+        }
+        Operand &operand = out.operands[out.count++];
+        operand.kind = operand_kind(field);
+        operand.value = extract(field, inst, next);
+        if(operand.kind == OPERAND_REL)
+        {
+            out.target = (pc + 1 + (operand.value >> 1)) & (FLASH_SIZE_WORDS - 1);
+        }
+        else if(operand.kind == OPERAND_CODE)
+        {
+            out.target = operand.value >> 1;
+        }
+    }
+}
+
+// how each operand kind is written: a prefix, then the value in a base,
+// with at least so many digits
+struct Format
+{
+    const char *prefix;
+    uint8_t base;
+    uint8_t digits;
+    bool upper;
+};
+
+static const Format formats[] = {
+    {"r", 10, 1, false},
+    {"0x", 16, 2, true},
+    {"0x", 16, 2, false},
+    {"", 10, 1, false},
+    {"0x", 16, 4, false},
+    {"0x", 16, 1, false},
+    {"", 10, 1, false},
+    // pointers are written by name
+    {"", 0, 0, false},
+    {"Y+", 10, 1, false},
+    {"Z+", 10, 1, false},
+};
+
+// fills a buffer without printf, counting what did not fit like snprintf
+class Text
+{
+protected:
+    char *buf;
+    size_t size;
+
+public:
+    size_t n;
+
+    Text(char *_buf, size_t _size)
+        : buf(_buf), size(_size), n(0)
+    {
+    }
+
+    ~Text()
+    {
+        if(size != 0)
+        {
+            buf[n < size ? n : size - 1] = 0;
+        }
+    }
+
+    void put(char c)
+    {
+        if(n + 1 < size)
+        {
+            buf[n] = c;
+        }
+        n++;
+    }
+
+    void put(const char *s)
+    {
+        while(*s != 0)
+        {
+            put(*s++);
+        }
+    }
+
+    void number(uint32_t value, const Format &format)
+    {
+        const char *digits = format.upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        char tmp[12];
+        int i = 0;
+
+        put(format.prefix);
+        do
+        {
+            tmp[i++] = digits[value % format.base];
+            value /= format.base;
+        }
+        while(value != 0 || i < format.digits);
+        while(i != 0)
+        {
+            put(tmp[--i]);
+        }
+    }
+};
+
+int Instruction::format(char *buf, size_t size, const Symbols *symbols) const
+{
+    Text text(buf, size);
+    const Symbol *symbol;
+
+    text.put(mnemonic);
+    for(uint8_t i = 0; i < count; i++)
+    {
+        const Operand &operand = operands[i];
+
+        text.put(i == 0 ? "\t" : ", ");
+        if(operand.kind == OPERAND_PTR)
+        {
+            text.put(pointer_names[operand.value]);
+        }
+        else if((operand.kind == OPERAND_Y || operand.kind == OPERAND_Z) && operand.value == 0)
+        {
+            // LD and ST through Y or Z themselves
+            text.put(operand.kind == OPERAND_Y ? 'Y' : 'Z');
+        }
+        else if(operand.kind == OPERAND_REL)
+        {
+            text.put(operand.value < 0 ? ".-" : ".+");
+            text.number(operand.value < 0 ? -operand.value : operand.value, formats[OPERAND_REL]);
+        }
+        else
+        {
+            text.number(operand.value, formats[operand.kind]);
+        }
+    }
+
+    if(op == NULL)
+    {
+        text.put("\t; ????");
+    }
+    else if(target >= 0)
+    {
+        symbol = symbols == NULL ? NULL : symbols->find((uint32_t)target << 1);
+        // a relative target is always spelled out, an absolute one only
+        // for its symbol
+        if(operands[count - 1].kind == OPERAND_REL || symbol != NULL)
+        {
+            text.put("\t; ");
+            text.number((uint32_t)target << 1, formats[OPERAND_CODE]);
+        }
+        if(symbol != NULL)
+        {
+            text.put(" <");
+            text.put(symbol->name.c_str());
+            if(symbol->addr != (uint32_t)target << 1)
+            {
+                text.put('+');
+                text.number(((uint32_t)target << 1) - symbol->addr, formats[OPERAND_CODE]);
+            }
+            text.put('>');
+        }
+    }
+    return text.n;
+}
@@ -0,0 +1,55 @@
+// decoder.hh
+
+#ifndef AVRE_DECODER_HH
+#define AVRE_DECODER_HH
+
+#include <cstddef>
+#include <cstdint>
+
+#include "opcode.hh"
+#include "symbols.hh"
+
+enum OperandKind
+{
+    OPERAND_REG,        // r0 to r31
+    OPERAND_IMM,        // an immediate
+    OPERAND_IO,         // an I/O address
+    OPERAND_BIT,        // a bit number
+    OPERAND_DATA,       // a data space address
+    OPERAND_CODE,       // a flash byte address
+    OPERAND_REL,        // a flash byte offset from the next instruction
+    OPERAND_PTR,        // X, X+, -X, Y+, -Y, Z, Z+ or -Z, by index
+    OPERAND_Y,          // Y+q
+    OPERAND_Z,          // Z+q
+};
+
+struct Operand
+{
+    uint8_t kind;
+    int32_t value;
+};
+
+// one instruction taken apart, as avr-objdump would write it
+struct Instruction
+{
+    // NULL for an illegal one, which is written as .word
+    const Opcode *op;
+    const char *mnemonic;
+    // word addresses; target is where a branch, jump or call goes, or -1
+    uint32_t pc;
+    int32_t target;
+    uint16_t inst;
+    uint16_t next;
+    uint8_t words;
+    uint8_t count;
+    Operand operands[2];
+
+    // next is the word after inst, looked at only by two-word instructions
+    static void decode(Instruction &out, uint32_t pc, uint16_t inst, uint16_t next);
+
+    // "mnemonic operands", with a comment giving the target and the symbol
+    // covering it, if any; returns the length like snprintf
+    int format(char *buf, size_t size, const Symbols *symbols = NULL) const;
+};
+
+#endif
@@ -0,0 +1,72 @@
+// elf.cc
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "elf.hh"
+
+ElfFile::ElfFile(const char *_fn)
+    : fn(_fn)
+{
+    uint8_t buf[4096];
+    size_t n;
+    FILE *f;
+
+    f = fopen(_fn, "rb");
+    if(f == NULL)
+    {
+        perror(_fn);
+        exit(1);
+    }
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    const Elf32_Ehdr &eh = *(const Elf32_Ehdr *)at(0, sizeof(Elf32_Ehdr));
+    if(memcmp(eh.e_ident, ELFMAG, SELFMAG) != 0 || eh.e_ident[EI_CLASS] != ELFCLASS32 || eh.e_ident[EI_DATA] != ELFDATA2LSB)
+    {
+        fprintf(stderr, "%s: not a 32-bit little-endian ELF file\n", _fn);
+        exit(1);
+    }
+    if(eh.e_machine != EM_AVR)
+    {
+        fprintf(stderr, "%s: not an AVR ELF file\n", _fn);
+        exit(1);
+    }
+    // the headers are indexed as arrays of these structures
+    if((eh.e_phnum != 0 && eh.e_phentsize != sizeof(Elf32_Phdr)) || (eh.e_shnum != 0 && eh.e_shentsize != sizeof(Elf32_Shdr)))
+    {
+        fprintf(stderr, "%s: unexpected ELF header entry size\n", _fn);
+        exit(1);
+    }
+    at(eh.e_phoff, eh.e_phnum * sizeof(Elf32_Phdr));
+    at(eh.e_shoff, eh.e_shnum * sizeof(Elf32_Shdr));
+}
+
+const Elf32_Ehdr &ElfFile::header() const
+{
+    return *(const Elf32_Ehdr *)data.data();
+}
+
+const Elf32_Phdr &ElfFile::segment(unsigned index) const
+{
+    return ((const Elf32_Phdr *)(data.data() + header().e_phoff))[index];
+}
+
+const Elf32_Shdr &ElfFile::section(unsigned index) const
+{
+    return ((const Elf32_Shdr *)(data.data() + header().e_shoff))[index];
+}
+
+const uint8_t *ElfFile::at(uint32_t offset, uint32_t size) const
+{
+    if(data.size() < offset || data.size() - offset < size)
+    {
+        fprintf(stderr, "%s: truncated ELF file\n", fn.c_str());
+        exit(1);
+    }
+    return data.data() + offset;
+}
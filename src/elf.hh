@@ -0,0 +1,37 @@
+// elf.hh
+
+#ifndef AVRE_ELF_HH
+#define AVRE_ELF_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <elf.h>
+
+#ifndef EM_AVR
+#define EM_AVR (83)
+#endif
+
+// AVR toolchains place data and EEPROM above this in the address space
+#define ELF_AVR_DATA_BASE (0x800000u)
+
+// a whole 32-bit little-endian AVR ELF file in memory; exits on anything
+// malformed
+class ElfFile
+{
+protected:
+    std::string fn;
+    std::vector<uint8_t> data;
+
+public:
+    ElfFile(const char *_fn);
+
+    const Elf32_Ehdr &header() const;
+    const Elf32_Phdr &segment(unsigned index) const;
+    const Elf32_Shdr &section(unsigned index) const;
+    // size bytes at offset, checked against the file size
+    const uint8_t *at(uint32_t offset, uint32_t size) const;
+};
+
+#endif
@@ -0,0 +1,173 @@
+// engine.hh
+
+#ifndef AVRE_ENGINE_HH
+#define AVRE_ENGINE_HH
+
+#include "avr.hh"
+#include "hooks.hh"
+#include "instruction.hh"
+#include "instruction_set.hh"
+
+// one step for the CPU type given, AVR itself, Instrumented or an
+// Engine<Hooks>; the accesses the core makes on its own behalf, keeping
+// SREG in step, do not go through the hooks
+template<class CPU>
+bool AVR::step(CPU *cpu)
+{
+    uint16_t inst, at;
+    int i, taken;
+
+    sreg.bits = read_byte(AVR_REG_SREG);
+
+    if(irq && sreg.I)
+    {
+        for(i = 0; i < IRQ_COUNT && (irq & ((uint64_t)1 << i)) == 0; i++);
+        irq ^= ((uint64_t)1 << i);
+        cpu->before_irq(i);
+        cpu->push_word(pc);
+        // vectors are two words apart (a JMP each)
+        pc = i << 1;
+        sreg.I = 0;
+        write_byte(AVR_REG_SREG, sreg.bits);
+        cycle += 4;
+        sleeping = false;
+        edge();
+        cpu->called(i, true);
+    }
+    if(sleeping)
+    {
+        cycle++;
+        return false;
+    }
+
+    at = pc;
+    cpu->before_exec(at);
+    inst = flash.words[pc++];
+    taken = CPU::instructions[inst](cpu, inst);
+    cycle += taken;
+    cpu->after_exec(at, taken);
+    write_byte(AVR_REG_SREG, sreg.bits);
+    return true;
+}
+
+// the interpreter instantiated for a hook set (see hooks.hh): the
+// instruction handlers are compiled again against this class, so the
+// members below, which hide AVR's, are what they call
+//
+//     struct Writes : NoHooks
+//     {
+//         void on_mem_write(AVR *avr, uint16_t addr, uint8_t data) { ... }
+//     };
+//
+//     Machine machine(new Engine<Writes>(fn, "ihex"), NULL);
+template<class Hooks>
+class Engine : public AVR
+{
+    friend class AVR;
+
+protected:
+    typedef int (*instruction)(Engine *, uint16_t);
+
+    static instruction instructions[INSTRUCTION_SPACE];
+    // the instruction being executed, for on_branch()
+    uint16_t exec_pc;
+
+public:
+    Hooks hooks;
+
+    Engine(const char *fn, const char *tp)
+        : AVR(fn, tp), exec_pc(0)
+    {
+    }
+
+    Engine(const FlashImage &image)
+        : AVR(image), exec_pc(0)
+    {
+    }
+
+    virtual void process()
+    {
+        executed = step(this);
+    }
+
+    void before_exec(uint16_t at)
+    {
+        exec_pc = at;
+        hooks.on_exec(this, at);
+    }
+
+    void before_irq(int num)
+    {
+        hooks.on_irq(this, num);
+    }
+
+    uint8_t read_byte(uint16_t addr)
+    {
+        uint8_t data = AVR::read_byte(addr);
+
+        hooks.on_mem_read(this, addr, data);
+        if(AVR_IO_START <= addr && addr < REGS_SIZE_BYTES)
+        {
+            hooks.on_io(this, addr, data, false);
+        }
+        return data;
+    }
+
+    void write_byte(uint16_t addr, uint8_t data)
+    {
+        hooks.on_mem_write(this, addr, data);
+        if(AVR_IO_START <= addr && addr < REGS_SIZE_BYTES)
+        {
+            hooks.on_io(this, addr, data, true);
+        }
+        AVR::write_byte(addr, data);
+    }
+
+    uint16_t read_word(uint16_t addr)
+    {
+        return (uint16_t)read_byte(addr) | (((uint16_t)read_byte(addr + 1)) << 8);
+    }
+
+    void write_word(uint16_t addr, uint16_t data)
+    {
+        write_byte(addr, data & 0xff);
+        write_byte(addr + 1, data >> 8);
+    }
+
+    uint8_t pop_byte()
+    {
+        set_sp(sp + 1);
+        return read_byte(sp);
+    }
+
+    void push_byte(uint8_t data)
+    {
+        write_byte(sp, data);
+        set_sp(sp - 1);
+    }
+
+    uint16_t pop_word()
+    {
+        set_sp(sp + 2);
+        return read_word(sp - 1);
+    }
+
+    void push_word(uint16_t data)
+    {
+        write_word(sp - 1, data);
+        set_sp(sp - 2);
+    }
+
+    void edge()
+    {
+        AVR::edge();
+        hooks.on_branch(this, exec_pc, pc);
+    }
+};
+
+template<class Hooks>
+typename Engine<Hooks>::instruction Engine<Hooks>::instructions[INSTRUCTION_SPACE] = {
+#include "instruction_handler.hh"
+};
+
+#endif
@@ -0,0 +1,92 @@
+// forkserver.cc
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "forkserver.hh"
+
+ForkServer::ForkServer(Machine *_machine, const char *name)
+    : FuzzTarget(_machine, name)
+{
+}
+
+ForkServer::~ForkServer()
+{
+}
+
+int ForkServer::run_file(const char *fn)
+{
+    uint8_t buf[4096];
+    ssize_t n;
+    int fd;
+
+    fd = fn == NULL ? 0 : open(fn, O_RDONLY);
+    if(fd < 0)
+    {
+        perror(fn);
+        return 1;
+    }
+    while((n = read(fd, buf, sizeof(buf))) > 0)
+    {
+        input.insert(input.end(), buf, buf + n);
+    }
+    if(fn != NULL)
+    {
+        close(fd);
+    }
+
+    if(execute(input.data(), input.size()) == STOP_FAULT)
+    {
+        // let the fuzzer see a crash
+        abort();
+    }
+    return 0;
+}
+
+void ForkServer::serve(const char *fn)
+{
+    uint32_t msg = 0;
+    int status;
+    pid_t pid;
+
+    if(write(FORKSRV_FD + 1, &msg, 4) != 4)
+    {
+        // not started by a fuzzer; run the single input directly
+        status = run_file(fn);
+#ifdef AVRE_CMPLOG
+        CmpLog::dump(stderr);
+#endif
+        exit(status);
+    }
+
+    while(read(FORKSRV_FD, &msg, 4) == 4)
+    {
+        pid = fork();
+        if(pid < 0)
+        {
+            perror("fork");
+            exit(1);
+        }
+        if(pid == 0)
+        {
+            close(FORKSRV_FD);
+            close(FORKSRV_FD + 1);
+            _exit(run_file(fn));
+        }
+
+        if(write(FORKSRV_FD + 1, &pid, 4) != 4 || waitpid(pid, &status, 0) < 0)
+        {
+            exit(1);
+        }
+        if(write(FORKSRV_FD + 1, &status, 4) != 4)
+        {
+            exit(1);
+        }
+    }
+    exit(0);
+}
@@ -0,0 +1,28 @@
+// forkserver.hh
+
+#ifndef AVRE_FORKSERVER_HH
+#define AVRE_FORKSERVER_HH
+
+#include <vector>
+
+#include "fuzz.hh"
+
+// AFL's control and status pipes are FORKSRV_FD and FORKSRV_FD + 1
+#define FORKSRV_FD (198)
+
+// forks a child of the booted target per test case
+class ForkServer : public FuzzTarget
+{
+protected:
+    std::vector<uint8_t> input;
+
+    int run_file(const char *fn);
+
+public:
+    ForkServer(Machine *_machine, const char *name);
+    virtual ~ForkServer();
+
+    void serve(const char *fn);
+};
+
+#endif
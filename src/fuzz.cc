@@ -0,0 +1,63 @@
+// fuzz.cc
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "fuzz.hh"
+
+FuzzTarget::FuzzTarget(Machine *_machine, const char *name)
+    : machine(_machine), snap(NULL)
+{
+    backend = new MemoryBackend();
+    usart = machine->isolate(name, backend);
+    if(usart == NULL)
+    {
+        fprintf(stderr, "no such usart -- '%s'\n", name);
+        exit(1);
+    }
+    stop.input = usart;
+    machine->initialize();
+}
+
+FuzzTarget::~FuzzTarget()
+{
+    delete snap;
+}
+
+void FuzzTarget::boot(long pc, uint64_t cycles)
+{
+    AVR *avr = machine->avr;
+
+    while(avr->fault == AVR_FAULT_NONE && avr->cycle < cycles)
+    {
+        if(pc < 0 ? usart->receiving() : avr->pc == (pc >> 1))
+        {
+            snap = new Snapshot();
+            avr->snapshot(*snap);
+            return;
+        }
+        machine->process();
+    }
+    fprintf(stderr, "boot did not reach the fork point\n");
+    exit(1);
+}
+
+StopReason FuzzTarget::execute(const uint8_t *data, size_t size)
+{
+    StopCondition run = stop;
+    StopReason reason;
+
+    if(stop.cycles < UINT64_MAX - snap->cycle)
+    {
+        run.cycles = snap->cycle + stop.cycles;
+    }
+    backend->feed(data, size);
+    backend->output.clear();
+#ifdef AVRE_CMPLOG
+    CmpLog::ring()->head = 0;
+#endif
+
+    reason = machine->run(run);
+    machine->avr->restore(*snap);
+    return reason;
+}
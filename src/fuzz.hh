@@ -0,0 +1,32 @@
+// fuzz.hh
+
+#ifndef AVRE_FUZZ_HH
+#define AVRE_FUZZ_HH
+
+#include "machine.hh"
+#include "usart.hh"
+
+// a booted machine that runs one input at a time through the RX side of
+// a USART, rewinding to the boot snapshot in between; no syscalls are
+// made per input as all USARTs are detached from their file descriptors
+class FuzzTarget
+{
+protected:
+    Machine *machine;
+    USART *usart;
+    MemoryBackend *backend;
+    Snapshot *snap;
+
+public:
+    // cycles are counted from the boot snapshot
+    StopCondition stop;
+
+    FuzzTarget(Machine *_machine, const char *name);
+    virtual ~FuzzTarget();
+
+    // runs until the byte address pc, or until the receiver is enabled
+    void boot(long pc, uint64_t cycles);
+    StopReason execute(const uint8_t *data, size_t size);
+};
+
+#endif
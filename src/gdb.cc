@@ -0,0 +1,852 @@
+// gdb.cc
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "condition.hh"
+#include "decoder.hh"
+#include "gdb.hh"
+
+// avr-gdb's register numbers
+#define GDB_REG_SREG (32u)
+#define GDB_REG_SP   (33u)
+#define GDB_REG_PC   (34u)
+
+// Z packet types
+#define GDB_Z_WRITE  (2)
+#define GDB_Z_READ   (3)
+#define GDB_Z_ACCESS (4)
+
+static const char digits[] = "0123456789abcdef";
+
+static void put_hex(std::string &out, uint8_t data)
+{
+    out += digits[data >> 4];
+    out += digits[data & 0xf];
+}
+
+static int nibble(char c)
+{
+    if('0' <= c && c <= '9')
+    {
+        return c - '0';
+    }
+    if('a' <= c && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if('A' <= c && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// pairs of hex digits; false if there is anything else
+static bool get_bytes(const std::string &hex, std::string &out)
+{
+    int hi, lo;
+
+    if(hex.size() % 2 != 0)
+    {
+        return false;
+    }
+    for(size_t i = 0; i < hex.size(); i += 2)
+    {
+        hi = nibble(hex[i]);
+        lo = nibble(hex[i + 1]);
+        if(hi < 0 || lo < 0)
+        {
+            return false;
+        }
+        out += (char)(hi << 4 | lo);
+    }
+    return true;
+}
+
+static std::string text(const char *s)
+{
+    std::string out;
+
+    while(*s)
+    {
+        put_hex(out, *s++);
+    }
+    return out;
+}
+
+GdbServer::GdbServer(Machine *_machine, Timeline *_timeline, const char *spec)
+    : machine(_machine), timeline(_timeline), listener(-1), fd(-1), ack(true)
+{
+    memset(breakpoints, 0, sizeof(breakpoints));
+    if(strncmp(spec, "unix:", 5) == 0)
+    {
+        listen_unix(spec + 5);
+    }
+    else if(strncmp(spec, "tcp:", 4) == 0)
+    {
+        listen_tcp(spec + 4);
+    }
+    else
+    {
+        fprintf(stderr, "unknown gdb address -- '%s'\n", spec);
+        exit(1);
+    }
+}
+
+GdbServer::~GdbServer()
+{
+    for(std::map<uint16_t, Condition *>::iterator it = conditions.begin(); it != conditions.end(); it++)
+    {
+        delete it->second;
+    }
+    if(fd >= 0)
+    {
+        close(fd);
+    }
+    close(listener);
+}
+
+void GdbServer::listen_unix(const char *path)
+{
+    struct sockaddr_un addr;
+
+    if(sizeof(addr.sun_path) <= strlen(path))
+    {
+        fprintf(stderr, "%s: socket path too long\n", path);
+        exit(1);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    unlink(path);
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0 || bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, 1) < 0)
+    {
+        perror(path);
+        exit(1);
+    }
+}
+
+void GdbServer::listen_tcp(const char *spec)
+{
+    struct addrinfo hints, *res, *ai;
+    std::string host(spec);
+    size_t colon;
+    int one = 1;
+
+    colon = host.rfind(':');
+    if(colon == std::string::npos)
+    {
+        fprintf(stderr, "%s: expected host:port\n", spec);
+        exit(1);
+    }
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    if(getaddrinfo(host.substr(0, colon).c_str(), host.c_str() + colon + 1, &hints, &res) != 0)
+    {
+        fprintf(stderr, "%s: cannot resolve address\n", spec);
+        exit(1);
+    }
+    for(ai = res; ai != NULL; ai = ai->ai_next)
+    {
+        listener = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if(listener < 0)
+        {
+            continue;
+        }
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if(bind(listener, ai->ai_addr, ai->ai_addrlen) == 0 && listen(listener, 1) == 0)
+        {
+            break;
+        }
+        close(listener);
+        listener = -1;
+    }
+    freeaddrinfo(res);
+    if(listener < 0)
+    {
+        perror(spec);
+        exit(1);
+    }
+}
+
+// the next packet's payload, acknowledged; false once the debugger is gone
+bool GdbServer::receive(std::string &packet)
+{
+    char buf[GDB_PACKET_SIZE];
+    size_t start, hash;
+    unsigned sum;
+    ssize_t n;
+
+    while(true)
+    {
+        start = in.find('$');
+        hash = start == std::string::npos ? std::string::npos : in.find('#', start);
+        if(hash != std::string::npos && hash + 2 < in.size())
+        {
+            packet = in.substr(start + 1, hash - start - 1);
+            sum = nibble(in[hash + 1]) << 4 | nibble(in[hash + 2]);
+            in.erase(0, hash + 3);
+            for(char c : packet)
+            {
+                sum -= (uint8_t)c;
+            }
+            if(ack && ::send(fd, (sum & 0xff) == 0 ? "+" : "-", 1, MSG_NOSIGNAL) != 1)
+            {
+                return false;
+            }
+            if(!ack || (sum & 0xff) == 0)
+            {
+                return true;
+            }
+            continue;
+        }
+        // acks, and interrupts that came after the stop
+        if(start == std::string::npos)
+        {
+            in.clear();
+        }
+        n = read(fd, buf, sizeof(buf));
+        if(n <= 0)
+        {
+            return false;
+        }
+        in.append(buf, n);
+    }
+}
+
+void GdbServer::send(const std::string &packet)
+{
+    std::string out = "$" + packet + "#";
+    uint8_t sum = 0;
+    size_t done = 0;
+    ssize_t n;
+    char c;
+
+    for(char p : packet)
+    {
+        sum += p;
+    }
+    put_hex(out, sum);
+
+    // a debugger that went away must not take the process with it
+    while(done < out.size())
+    {
+        n = ::send(fd, out.data() + done, out.size() - done, MSG_NOSIGNAL);
+        if(n <= 0)
+        {
+            return;
+        }
+        done += n;
+    }
+    // a NAK asks for it again; anything else is already the next packet
+    if(ack && read(fd, &c, 1) == 1)
+    {
+        if(c == '-')
+        {
+            send(packet);
+        }
+        else if(c != '+')
+        {
+            in += c;
+        }
+    }
+}
+
+// a ^C from the debugger while the machine runs; a closed connection
+// stops it too
+bool GdbServer::interrupted()
+{
+    struct pollfd p = {fd, POLLIN, 0};
+    char buf[GDB_PACKET_SIZE];
+    ssize_t n;
+    size_t brk;
+
+    if(poll(&p, 1, 0) <= 0)
+    {
+        return false;
+    }
+    n = read(fd, buf, sizeof(buf));
+    if(n <= 0)
+    {
+        return true;
+    }
+    in.append(buf, n);
+    brk = in.find('\x03');
+    if(brk == std::string::npos)
+    {
+        return false;
+    }
+    in.erase(brk, 1);
+    return true;
+}
+
+void GdbServer::set_breakpoint(uint16_t pc, bool set)
+{
+    std::map<uint16_t, Condition *>::iterator it = conditions.find(pc);
+
+    if(set)
+    {
+        breakpoints[pc >> 3] |= 1 << (pc & 7);
+        return;
+    }
+    breakpoints[pc >> 3] &= ~(1 << (pc & 7));
+    if(it != conditions.end())
+    {
+        delete it->second;
+        conditions.erase(it);
+    }
+}
+
+// counts a hit at a breakpoint and tells whether it stops there
+bool GdbServer::stops(uint16_t pc)
+{
+    std::map<uint16_t, Condition *>::iterator it = conditions.find(pc);
+
+    return it == conditions.end() || it->second->hit(machine->avr);
+}
+
+void GdbServer::step()
+{
+    if(timeline != NULL)
+    {
+        timeline->step();
+    }
+    else
+    {
+        machine->process();
+    }
+}
+
+// breakpoints are looked up in the bitmap between steps of this loop
+// only, so they cost nothing outside a debugging session, and only a pc
+// found there has its condition evaluated
+std::string GdbServer::resume(bool single)
+{
+    AVR *avr = machine->avr;
+    uint64_t n = 0;
+
+    avr->watched = false;
+    while(true)
+    {
+        step();
+        if(single || avr->fault != AVR_FAULT_NONE || avr->watched || (breakpoint(avr->pc) && stops(avr->pc)))
+        {
+            return stopped();
+        }
+        if(++n % GDB_POLL_STEPS == 0 && interrupted())
+        {
+            return "S02";
+        }
+    }
+}
+
+// back one step, or to the latest earlier breakpoint or watchpoint hit,
+// stopping at the start of the recording if there is none
+std::string GdbServer::reverse(bool single)
+{
+    AVR *avr = machine->avr;
+    WatchHit hit;
+    bool watched = false;
+
+    if(timeline == NULL)
+    {
+        return "E01";
+    }
+    if(single)
+    {
+        return timeline->step_back(1) ? "S05" : "T05replaylog:begin;";
+    }
+    if(!timeline->search_back([this, avr, &hit, &watched](bool after)
+        {
+            if(!after)
+            {
+                // hit counts are left as they are on the way back
+                if(!breakpoint(avr->pc) || (conditions.count(avr->pc) != 0 && !conditions[avr->pc]->test(avr)))
+                {
+                    return false;
+                }
+                watched = false;
+                return true;
+            }
+            if(avr->watched)
+            {
+                hit = avr->watch_hit;
+                watched = true;
+            }
+            return avr->watched;
+        }))
+    {
+        timeline->seek(0);
+        return "T05replaylog:begin;";
+    }
+    avr->watched = watched;
+    avr->watch_hit = hit;
+    return stopped();
+}
+
+std::string GdbServer::stopped()
+{
+    AVR *avr = machine->avr;
+    const char *kind;
+    char buf[64];
+
+    switch(avr->fault)
+    {
+    case AVR_FAULT_NONE:
+        break;
+    case AVR_FAULT_STACK:
+        return "S0b";
+    default:
+        return "S04";
+    }
+    if(!avr->watched)
+    {
+        return "S05";
+    }
+    switch(watch_types[avr->watch_hit.id])
+    {
+    case GDB_Z_READ:
+        kind = "rwatch";
+        break;
+    case GDB_Z_ACCESS:
+        kind = "awatch";
+        break;
+    default:
+        kind = "watch";
+        break;
+    }
+    snprintf(buf, sizeof(buf), "T05%s:%x;", kind, GDB_DATA_OFFSET + avr->watch_hit.addr);
+    return buf;
+}
+
+// r0 to r31, SREG, SP and the pc as a byte address, all little-endian
+std::string GdbServer::read_registers()
+{
+    AVR *avr = machine->avr;
+    uint32_t pc = (uint32_t)avr->pc << 1;
+    std::string out;
+
+    for(unsigned i = 0; i < 32; i++)
+    {
+        put_hex(out, avr->sram.bytes[i]);
+    }
+    put_hex(out, avr->sram.bytes[AVR_REG_SREG]);
+    put_hex(out, avr->sp & 0xff);
+    put_hex(out, avr->sp >> 8);
+    for(unsigned i = 0; i < 4; i++)
+    {
+        put_hex(out, pc >> (i * 8));
+    }
+    return out;
+}
+
+bool GdbServer::write_register(unsigned num, const std::string &hex)
+{
+    AVR *avr = machine->avr;
+    std::string data;
+    uint32_t pc = 0;
+
+    if(!get_bytes(hex, data))
+    {
+        return false;
+    }
+    if(num < 32 || num == GDB_REG_SREG)
+    {
+        if(data.size() != 1)
+        {
+            return false;
+        }
+        avr->poke(num < 32 ? num : AVR_REG_SREG, data[0]);
+        return true;
+    }
+    if(num == GDB_REG_SP && data.size() == 2)
+    {
+        avr->poke(AVR_REG_SPL, data[0]);
+        avr->poke(AVR_REG_SPH, data[1]);
+        return true;
+    }
+    if(num == GDB_REG_PC && data.size() == 4)
+    {
+        for(unsigned i = 0; i < 4; i++)
+        {
+            pc |= (uint32_t)(uint8_t)data[i] << (i * 8);
+        }
+        avr->pc = pc >> 1;
+        return true;
+    }
+    return false;
+}
+
+// flash below GDB_DATA_OFFSET, SRAM from it; data is read as it is, with
+// no access handlers run
+std::string GdbServer::read_memory(uint32_t addr, uint32_t size)
+{
+    AVR *avr = machine->avr;
+    std::string out;
+    uint32_t a;
+
+    for(uint32_t i = 0; i < size; i++)
+    {
+        a = addr + i;
+        if(a < FLASH_SIZE_BYTES)
+        {
+            put_hex(out, avr->flash.bytes[a]);
+        }
+        else if(GDB_DATA_OFFSET <= a && a < GDB_DATA_OFFSET + SRAM_SIZE_BYTES)
+        {
+            put_hex(out, avr->sram.bytes[a - GDB_DATA_OFFSET]);
+        }
+        else
+        {
+            break;
+        }
+    }
+    return out.empty() && size != 0 ? "E01" : out;
+}
+
+bool GdbServer::write_memory(uint32_t addr, const std::string &hex)
+{
+    AVR *avr = machine->avr;
+    std::string data;
+    uint32_t a;
+
+    if(!get_bytes(hex, data))
+    {
+        return false;
+    }
+    for(size_t i = 0; i < data.size(); i++)
+    {
+        a = addr + i;
+        if(a < FLASH_SIZE_BYTES)
+        {
+            avr->flash.bytes[a] = data[i];
+        }
+        else if(GDB_DATA_OFFSET <= a && a < GDB_DATA_OFFSET + SRAM_SIZE_BYTES)
+        {
+            avr->poke(a - GDB_DATA_OFFSET, data[i]);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Z and z: type,addr,kind
+std::string GdbServer::set_point(const std::string &args, bool insert)
+{
+    AVR *avr = machine->avr;
+    std::map<std::pair<int, uint32_t>, int>::iterator it;
+    unsigned long type, addr, size;
+    uint8_t kind;
+    char *end;
+
+    type = strtoul(args.c_str(), &end, 16);
+    if(*end != ',')
+    {
+        return "E01";
+    }
+    addr = strtoul(end + 1, &end, 16);
+    if(*end != ',')
+    {
+        return "E01";
+    }
+    size = strtoul(end + 1, &end, 16);
+
+    // software and hardware breakpoints are the same thing here
+    if(type <= 1)
+    {
+        if(FLASH_SIZE_BYTES <= addr)
+        {
+            return "E01";
+        }
+        set_breakpoint(addr >> 1, insert);
+        return "OK";
+    }
+    if(GDB_Z_ACCESS < type)
+    {
+        return "";
+    }
+    if(addr < GDB_DATA_OFFSET || GDB_DATA_OFFSET + SRAM_SIZE_BYTES <= addr || size == 0)
+    {
+        return "E01";
+    }
+
+    it = watches.find(std::make_pair((int)type, (uint32_t)addr));
+    if(!insert)
+    {
+        if(it == watches.end())
+        {
+            return "E01";
+        }
+        avr->remove_watch(it->second);
+        watch_types.erase(it->second);
+        watches.erase(it);
+        return "OK";
+    }
+    if(it != watches.end())
+    {
+        return "OK";
+    }
+    kind = type == GDB_Z_WRITE ? WATCH_WRITE : type == GDB_Z_READ ? WATCH_READ : WATCH_READ | WATCH_WRITE;
+    watches[std::make_pair((int)type, (uint32_t)addr)] = avr->add_watch(addr - GDB_DATA_OFFSET, size, kind, -1);
+    watch_types[watches[std::make_pair((int)type, (uint32_t)addr)]] = type;
+    return "OK";
+}
+
+// "monitor ..." in gdb; the output goes back hex encoded
+std::string GdbServer::monitor(const std::string &cmd)
+{
+    AVR *avr = machine->avr;
+    Condition *condition = NULL;
+    std::string error, out;
+    unsigned long addr, count;
+    const char *rest;
+    Instruction inst;
+    uint32_t pc;
+    char *end;
+    char buf[192], line[128];
+
+    if(cmd == "reset")
+    {
+        if(timeline != NULL)
+        {
+            return text("reset cannot be stepped back over; detach and start again\n");
+        }
+        machine->initialize();
+        return text("reset\n");
+    }
+    if(cmd == "cycles")
+    {
+        // machine->steps also counts what the timeline ran again
+        snprintf(buf, sizeof(buf), "cycle %llu, step %llu, pc %x\n", (unsigned long long)avr->cycle,
+            (unsigned long long)(timeline != NULL ? timeline->steps : machine->steps), (uint32_t)avr->pc << 1);
+        return text(buf);
+    }
+    // break addr [if condition], compiled here once rather than evaluated
+    // by the debugger on every hit
+    if(cmd.compare(0, 6, "break ") == 0 || cmd.compare(0, 7, "delete ") == 0)
+    {
+        rest = cmd.c_str() + cmd.find(' ') + 1;
+        addr = strtoul(rest, &end, 0);
+        while(*end == ' ')
+        {
+            end++;
+        }
+        if(end == rest || FLASH_SIZE_BYTES <= addr || (*end != 0 && (cmd[0] == 'd' || strncmp(end, "if ", 3) != 0)))
+        {
+            return text("usage: break addr [if condition], delete addr\n");
+        }
+        if(*end != 0)
+        {
+            condition = Condition::compile(end + 3, error);
+            if(condition == NULL)
+            {
+                return text((error + "\n").c_str());
+            }
+        }
+        set_breakpoint(addr >> 1, false);
+        if(cmd[0] == 'd')
+        {
+            return text("deleted\n");
+        }
+        if(condition != NULL)
+        {
+            conditions[addr >> 1] = condition;
+        }
+        set_breakpoint(addr >> 1, true);
+        return text("breakpoint set\n");
+    }
+    // disas [addr [count]], from the pc by default, marking where it is
+    if(cmd == "disas" || cmd.compare(0, 6, "disas ") == 0)
+    {
+        addr = cmd.size() > 6 ? strtoul(cmd.c_str() + 6, &end, 0) : (uint32_t)avr->pc << 1;
+        count = cmd.size() > 6 ? strtoul(end, NULL, 0) : 0;
+        pc = (addr >> 1) & (FLASH_SIZE_WORDS - 1);
+        for(unsigned long i = 0; i < (count == 0 ? 8 : count) && i < GDB_DISAS_MAX; i++)
+        {
+            Instruction::decode(inst, pc, avr->flash.words[pc], avr->flash.words[(pc + 1) & (FLASH_SIZE_WORDS - 1)]);
+            inst.format(line, sizeof(line));
+            snprintf(buf, sizeof(buf), "%s%5x:\t%s\n", pc == avr->pc ? "=> " : "   ", pc << 1, line);
+            out += buf;
+            pc = (pc + inst.words) & (FLASH_SIZE_WORDS - 1);
+        }
+        return text(out.c_str());
+    }
+    if(cmd == "conditions")
+    {
+        for(std::map<uint16_t, Condition *>::iterator it = conditions.begin(); it != conditions.end(); it++)
+        {
+            snprintf(buf, sizeof(buf), "%x: %llu hits, if ", (uint32_t)it->first << 1, (unsigned long long)it->second->hits);
+            out += buf + it->second->text + "\n";
+        }
+        return text(out.empty() ? "no conditional breakpoints\n" : out.c_str());
+    }
+    return text("monitor commands: reset, cycles, break addr [if condition], delete addr, conditions, disas [addr [count]]\n");
+}
+
+void GdbServer::serve()
+{
+    AVR *avr = machine->avr;
+    std::string packet, reply, data;
+    unsigned long addr, size;
+    char *end;
+    int one = 1;
+
+    fprintf(stderr, "gdb: waiting for a connection\n");
+    fd = accept(listener, NULL, NULL);
+    if(fd < 0)
+    {
+        perror("accept");
+        exit(1);
+    }
+    // a no-op on Unix sockets
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    ack = true;
+    in.clear();
+
+    while(receive(packet))
+    {
+        reply = "";
+        switch(packet[0])
+        {
+        case '?':
+            reply = stopped();
+            break;
+        case 'g':
+            reply = read_registers();
+            break;
+        case 'G':
+            // r0 to r31, SREG, SP, pc
+            reply = "OK";
+            for(unsigned i = 0, pos = 1; i <= GDB_REG_PC && reply == "OK"; i++)
+            {
+                size = i == GDB_REG_PC ? 8 : i == GDB_REG_SP ? 4 : 2;
+                if(!write_register(i, packet.substr(pos, size)))
+                {
+                    reply = "E01";
+                }
+                pos += size;
+            }
+            break;
+        case 'p':
+            addr = strtoul(packet.c_str() + 1, NULL, 16);
+            data = read_registers();
+            if(addr < GDB_REG_SP)
+            {
+                reply = data.substr(addr * 2, 2);
+            }
+            else if(addr == GDB_REG_SP)
+            {
+                reply = data.substr(addr * 2, 4);
+            }
+            else if(addr == GDB_REG_PC)
+            {
+                reply = data.substr(addr * 2 + 2, 8);
+            }
+            else
+            {
+                reply = "E01";
+            }
+            break;
+        case 'P':
+            addr = strtoul(packet.c_str() + 1, &end, 16);
+            reply = *end == '=' && write_register(addr, end + 1) ? "OK" : "E01";
+            break;
+        case 'm':
+            addr = strtoul(packet.c_str() + 1, &end, 16);
+            size = *end == ',' ? strtoul(end + 1, NULL, 16) : 0;
+            reply = read_memory(addr, size < GDB_PACKET_SIZE / 2 ? size : GDB_PACKET_SIZE / 2);
+            break;
+        case 'M':
+            addr = strtoul(packet.c_str() + 1, &end, 16);
+            end = strchr(end, ':');
+            reply = end != NULL && write_memory(addr, end + 1) ? "OK" : "E01";
+            break;
+        case 'c':
+        case 's':
+            if(packet.size() > 1)
+            {
+                avr->pc = strtoul(packet.c_str() + 1, NULL, 16) >> 1;
+            }
+            reply = resume(packet[0] == 's');
+            break;
+        case 'b':
+            reply = packet == "bs" ? reverse(true) : packet == "bc" ? reverse(false) : "";
+            break;
+        case 'Z':
+        case 'z':
+            reply = set_point(packet.substr(1), packet[0] == 'Z');
+            break;
+        case 'H':
+        case 'T':
+            reply = "OK";
+            break;
+        case 'k':
+            fprintf(stderr, "gdb: killed\n");
+            exit(0);
+        case 'D':
+            send("OK");
+            fprintf(stderr, "gdb: detached\n");
+            return;
+        case 'q':
+            if(packet.compare(0, 10, "qSupported") == 0)
+            {
+                reply = "PacketSize=1000;QStartNoAckMode+";
+                if(timeline != NULL)
+                {
+                    reply += ";ReverseStep+;ReverseContinue+";
+                }
+            }
+            else if(packet == "qAttached")
+            {
+                reply = "1";
+            }
+            else if(packet == "qC")
+            {
+                reply = "QC1";
+            }
+            else if(packet == "qfThreadInfo")
+            {
+                reply = "m1";
+            }
+            else if(packet == "qsThreadInfo")
+            {
+                reply = "l";
+            }
+            else if(packet.compare(0, 6, "qRcmd,") == 0)
+            {
+                data.clear();
+                reply = get_bytes(packet.substr(6), data) ? monitor(data) : "E01";
+            }
+            break;
+        case 'Q':
+            if(packet == "QStartNoAckMode")
+            {
+                send("OK");
+                ack = false;
+                continue;
+            }
+            break;
+        }
+        send(reply);
+    }
+    fprintf(stderr, "gdb: connection closed\n");
+}
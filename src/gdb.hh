@@ -0,0 +1,78 @@
+// gdb.hh
+
+#ifndef AVRE_GDB_HH
+#define AVRE_GDB_HH
+
+#include <map>
+#include <string>
+
+#include "condition.hh"
+#include "machine.hh"
+#include "timeline.hh"
+
+// avr-gdb's data space and its other non-flash spaces start here
+#define GDB_DATA_OFFSET   (0x800000u)
+#define GDB_EEPROM_OFFSET (0x810000u)
+#define GDB_PACKET_SIZE   (0x1000u)
+// the socket is looked at for an interrupt every so many steps
+#define GDB_POLL_STEPS    (0x10000u)
+// the most "monitor disas" lists at once
+#define GDB_DISAS_MAX     (256u)
+
+// a GDB remote serial protocol server for one connection at a time, on
+// tcp:host:port or unix:path; it runs the machine itself while the
+// debugger lets it, through the timeline when there is one, which is
+// what reverse stepping and continuing go back on
+class GdbServer
+{
+protected:
+    Machine *machine;
+    Timeline *timeline;
+    int listener;
+    int fd;
+    bool ack;
+    std::string in;
+    // one bit per word address, looked at between steps of a resume only
+    uint8_t breakpoints[FLASH_SIZE_WORDS / 8];
+    // set with "monitor break addr if ...", by word address
+    std::map<uint16_t, Condition *> conditions;
+    // watchpoints by Z type and address, and the type of each by id
+    std::map<std::pair<int, uint32_t>, int> watches;
+    std::map<int, int> watch_types;
+
+    void listen_unix(const char *path);
+    void listen_tcp(const char *spec);
+
+    bool receive(std::string &packet);
+    void send(const std::string &packet);
+    bool interrupted();
+
+    bool breakpoint(uint16_t pc) const
+    {
+        return breakpoints[pc >> 3] & (1 << (pc & 7));
+    }
+
+    // clearing one drops its condition too
+    void set_breakpoint(uint16_t pc, bool set);
+    bool stops(uint16_t pc);
+    void step();
+    std::string resume(bool single);
+    std::string reverse(bool single);
+    std::string stopped();
+
+    std::string read_registers();
+    std::string read_memory(uint32_t addr, uint32_t size);
+    bool write_memory(uint32_t addr, const std::string &hex);
+    bool write_register(unsigned num, const std::string &hex);
+    std::string set_point(const std::string &args, bool insert);
+    std::string monitor(const std::string &cmd);
+
+public:
+    GdbServer(Machine *_machine, Timeline *_timeline, const char *spec);
+    ~GdbServer();
+
+    // returns once the debugger detaches; kill exits
+    void serve();
+};
+
+#endif
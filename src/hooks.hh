@@ -0,0 +1,50 @@
+// hooks.hh
+
+#ifndef AVRE_HOOKS_HH
+#define AVRE_HOOKS_HH
+
+#include <cstdint>
+
+class AVR;
+
+// the instrumentation points of Engine<Hooks>; a hook set derives from
+// NoHooks and hides the members it wants called; the build is optimized
+// (see the Makefile), so the rest are inlined away. Addresses are word
+// addresses in flash and byte addresses in data space
+struct NoHooks
+{
+    // before the instruction at pc is fetched
+    void on_exec(AVR *avr, uint16_t pc)
+    {
+    }
+
+    // every data space access an instruction makes, registers included,
+    // and the pushes of interrupt entry; reads see the value read, writes
+    // the value about to be stored
+    void on_mem_read(AVR *avr, uint16_t addr, uint8_t data)
+    {
+    }
+
+    void on_mem_write(AVR *avr, uint16_t addr, uint8_t data)
+    {
+    }
+
+    // after each control-flow instruction, taken or not; to is the pc it
+    // continues at
+    void on_branch(AVR *avr, uint16_t from, uint16_t to)
+    {
+    }
+
+    // once interrupt num is taken, before the return address is pushed
+    void on_irq(AVR *avr, int num)
+    {
+    }
+
+    // accesses to the I/O space, 0x20 to 0xff, after on_mem_read() or
+    // before on_mem_write()
+    void on_io(AVR *avr, uint16_t addr, uint8_t data, bool write)
+    {
+    }
+};
+
+#endif
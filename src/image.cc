@@ -0,0 +1,73 @@
+// image.cc
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "avr.hh"
+#include "image.hh"
+
+FlashImage::FlashImage()
+{
+    create();
+}
+
+FlashImage::FlashImage(const char *fn, const char *tp)
+{
+    create();
+    if(strcasecmp(tp, "elf") == 0)
+    {
+        load_elf(fn);
+    }
+    else if(strcasecmp(tp, "ihex") == 0)
+    {
+        load_ihex(fn);
+    }
+    else if(strcasecmp(tp, "bin") == 0)
+    {
+        load_bin(fn);
+    }
+    else
+    {
+        fprintf(stderr, "unknown file type -- '%s'\n\n", tp);
+        exit(1);
+    }
+}
+
+void FlashImage::create()
+{
+    fd = memfd_create("avre-flash", MFD_CLOEXEC);
+    if(fd < 0 || ftruncate(fd, FLASH_SIZE_BYTES) < 0)
+    {
+        perror("memfd_create");
+        exit(1);
+    }
+    flash = (struct FLASH *)mmap(NULL, FLASH_SIZE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(flash == MAP_FAILED)
+    {
+        perror("mmap");
+        exit(1);
+    }
+}
+
+FlashImage::~FlashImage()
+{
+    munmap(flash, FLASH_SIZE_BYTES);
+    close(fd);
+}
+
+struct FLASH &FlashImage::map() const
+{
+    void *p;
+
+    p = mmap(NULL, FLASH_SIZE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if(p == MAP_FAILED)
+    {
+        perror("mmap");
+        exit(1);
+    }
+    return *(struct FLASH *)p;
+}
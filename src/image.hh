@@ -0,0 +1,30 @@
+// image.hh
+
+#ifndef AVRE_IMAGE_HH
+#define AVRE_IMAGE_HH
+
+struct FLASH;
+
+// a firmware image parsed once into an in-memory file; every AVR maps it
+// privately, so instances share the pages until one of them writes flash
+class FlashImage
+{
+protected:
+    int fd;
+    struct FLASH *flash;
+
+    void create();
+    void load_elf(const char *fn);
+    void load_ihex(const char *fn);
+    void load_bin(const char *fn);
+
+public:
+    // all zeros, which is NOPs, for programs written in place
+    FlashImage();
+    FlashImage(const char *fn, const char *tp);
+    virtual ~FlashImage();
+
+    struct FLASH &map() const;
+};
+
+#endif
@@ -1,260 +1,259 @@
-AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NOP,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_MOVW,
   do_MOVW,
   do_MOVW,
@@ -36866,15 +36865,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36882,15 +36881,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36898,15 +36897,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36914,15 +36913,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36930,15 +36929,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36946,15 +36945,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36962,15 +36961,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36978,15 +36977,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -36994,15 +36993,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37010,15 +37009,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37026,15 +37025,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37042,15 +37041,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37058,15 +37057,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37074,15 +37073,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37090,15 +37089,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37106,15 +37105,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37122,15 +37121,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37138,15 +37137,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37154,15 +37153,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37170,15 +37169,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37186,15 +37185,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37202,15 +37201,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37218,15 +37217,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37234,15 +37233,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37250,15 +37249,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37266,15 +37265,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37282,15 +37281,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37298,15 +37297,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37314,15 +37313,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37330,15 +37329,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37346,15 +37345,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37362,15 +37361,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_LDS,
   do_LD_Z2,
   do_LD_Z3,
-  NULL,
+  do_ILLEGAL,
   do_LPM_2,
   do_LPM_3,
   do_ELPM_2,
   do_ELPM_3,
-  NULL,
+  do_ILLEGAL,
   do_LD_Y2,
   do_LD_Y3,
-  NULL,
+  do_ILLEGAL,
   do_LD_X1,
   do_LD_X2,
   do_LD_X3,
@@ -37378,15 +37377,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37394,15 +37393,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37410,15 +37409,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37426,15 +37425,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37442,15 +37441,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37458,15 +37457,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37474,15 +37473,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37490,15 +37489,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37506,15 +37505,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37522,15 +37521,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37538,15 +37537,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37554,15 +37553,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37570,15 +37569,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37586,15 +37585,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37602,15 +37601,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37618,15 +37617,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37634,15 +37633,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37650,15 +37649,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37666,15 +37665,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37682,15 +37681,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37698,15 +37697,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37714,15 +37713,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37730,15 +37729,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37746,15 +37745,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37762,15 +37761,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37778,15 +37777,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37794,15 +37793,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37810,15 +37809,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37826,15 +37825,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37842,15 +37841,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37858,15 +37857,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37874,15 +37873,15 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_STS,
   do_ST_Z2,
   do_ST_Z3,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_ST_Y2,
   do_ST_Y3,
-  NULL,
+  do_ILLEGAL,
   do_ST_X1,
   do_ST_X2,
   do_ST_X3,
@@ -37891,7 +37890,7 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
@@ -37907,7 +37906,7 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
@@ -37923,12 +37922,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BSET,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -37939,12 +37938,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BSET,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -37955,12 +37954,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BSET,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -37971,12 +37970,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BSET,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -37987,12 +37986,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BSET,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38003,12 +38002,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BSET,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38019,12 +38018,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38035,12 +38034,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38051,12 +38050,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38067,12 +38066,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38083,12 +38082,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38099,12 +38098,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38115,12 +38114,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38131,12 +38130,12 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BCLR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
   do_DES,
   do_JMP,
@@ -38147,14 +38146,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_RET,
   do_ICALL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38163,14 +38162,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_RETI,
   do_EICALL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38179,14 +38178,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38195,14 +38194,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38211,14 +38210,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38227,14 +38226,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38243,14 +38242,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38259,14 +38258,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38275,14 +38274,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_SLEEP,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38291,14 +38290,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_BREAK,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38307,14 +38306,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_WDR,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38323,14 +38322,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38339,14 +38338,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_LPM_1,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38355,14 +38354,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_ELPM_1,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38371,14 +38370,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_SPM2_1,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -38387,14 +38386,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_NEG,
   do_SWAP,
   do_INC,
-  NULL,
+  do_ILLEGAL,
   do_ASR,
   do_LSR,
   do_ROR,
   do_SPM2_2,
-  NULL,
+  do_ILLEGAL,
   do_DEC,
-  NULL,
+  do_ILLEGAL,
   do_JMP,
   do_JMP,
   do_CALL,
@@ -63495,14 +63494,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63511,14 +63510,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63527,14 +63526,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63543,14 +63542,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63559,14 +63558,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63575,14 +63574,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63591,14 +63590,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63607,14 +63606,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63623,14 +63622,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63639,14 +63638,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63655,14 +63654,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63671,14 +63670,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63687,14 +63686,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63703,14 +63702,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63719,14 +63718,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63735,14 +63734,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63751,14 +63750,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63767,14 +63766,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63783,14 +63782,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63799,14 +63798,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63815,14 +63814,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63831,14 +63830,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63847,14 +63846,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63863,14 +63862,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63879,14 +63878,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63895,14 +63894,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63911,14 +63910,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63927,14 +63926,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63943,14 +63942,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63959,14 +63958,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63975,14 +63974,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BLD,
   do_BLD,
   do_BLD,
@@ -63991,14 +63990,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BLD,
   do_BLD,
   do_BLD,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64007,14 +64006,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64023,14 +64022,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64039,14 +64038,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64055,14 +64054,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64071,14 +64070,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64087,14 +64086,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64103,14 +64102,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64119,14 +64118,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64135,14 +64134,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64151,14 +64150,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64167,14 +64166,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64183,14 +64182,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64199,14 +64198,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64215,14 +64214,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64231,14 +64230,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64247,14 +64246,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64263,14 +64262,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64279,14 +64278,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64295,14 +64294,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64311,14 +64310,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64327,14 +64326,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64343,14 +64342,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64359,14 +64358,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64375,14 +64374,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64391,14 +64390,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64407,14 +64406,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64423,14 +64422,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64439,14 +64438,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64455,14 +64454,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64471,14 +64470,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64487,14 +64486,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_BST,
   do_BST,
   do_BST,
@@ -64503,14 +64502,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_BST,
   do_BST,
   do_BST,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64519,14 +64518,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64535,14 +64534,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64551,14 +64550,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64567,14 +64566,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64583,14 +64582,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64599,14 +64598,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64615,14 +64614,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64631,14 +64630,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64647,14 +64646,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64663,14 +64662,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64679,14 +64678,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64695,14 +64694,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64711,14 +64710,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64727,14 +64726,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64743,14 +64742,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64759,14 +64758,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64775,14 +64774,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64791,14 +64790,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64807,14 +64806,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64823,14 +64822,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64839,14 +64838,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64855,14 +64854,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64871,14 +64870,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64887,14 +64886,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64903,14 +64902,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64919,14 +64918,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64935,14 +64934,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64951,14 +64950,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64967,14 +64966,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64983,14 +64982,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -64999,14 +64998,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRC,
   do_SBRC,
   do_SBRC,
@@ -65015,14 +65014,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRC,
   do_SBRC,
   do_SBRC,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65031,14 +65030,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65047,14 +65046,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65063,14 +65062,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65079,14 +65078,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65095,14 +65094,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65111,14 +65110,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65127,14 +65126,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65143,14 +65142,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65159,14 +65158,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65175,14 +65174,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65191,14 +65190,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65207,14 +65206,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65223,14 +65222,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65239,14 +65238,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65255,14 +65254,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65271,14 +65270,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65287,14 +65286,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65303,14 +65302,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65319,14 +65318,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65335,14 +65334,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65351,14 +65350,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65367,14 +65366,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65383,14 +65382,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65399,14 +65398,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65415,14 +65414,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65431,14 +65430,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65447,14 +65446,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65463,14 +65462,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65479,14 +65478,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65495,14 +65494,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65511,14 +65510,14 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
   do_SBRS,
   do_SBRS,
   do_SBRS,
@@ -65527,12 +65526,11 @@ AVR::instruction AVR::instructions[INSTRUCTION_SPACE] = {
   do_SBRS,
   do_SBRS,
   do_SBRS,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-  NULL,
-};
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
+  do_ILLEGAL,
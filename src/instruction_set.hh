@@ -0,0 +1,1188 @@
+// instruction_set.hh
+
+#ifndef AVRE_INSTRUCTION_SET_HH
+#define AVRE_INSTRUCTION_SET_HH
+
+#include <cstddef>
+
+#include "avr.hh"
+#include "instruction.hh"
+
+// the instruction handlers, as templates over the CPU type so that each
+// Engine<Hooks> gets its own copy calling its own read_byte() and
+// friends; instruction_handler.hh lists them in opcode order
+
+static inline bool extended_inst(uint16_t inst) {
+    return (inst & 0xfe0e) == 0x940e // CALL
+        || (inst & 0xfe0e) == 0x940c // JMP
+        || (inst & 0xfe0f) == 0x9000 // LDS
+        || (inst & 0xfe0f) == 0x9200; // STS
+}
+
+template<class CPU>
+static int do_ADC(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rd + Rr + (avr->sreg.C ? 1 : 0);
+    avr->sreg.H = (((Rr & Rd) | (Rr & ~x) | (~x & Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & Rr & ~x) | (~Rd & ~Rr & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = (((Rd & Rr) | (Rr & ~x) | (~x & Rd)) & 0x80) != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_ADD(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rd + Rr;
+    avr->sreg.H = (((Rd & Rr) | (Rr & ~x) | (~x & Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & Rr & ~x) | (~Rd & ~Rr & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = (((Rd & Rr) | (Rr & ~x) | (~x & Rd)) & 0x80) != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_ADIW(CPU *avr, uint16_t inst)
+{
+    // --------KKddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 2) & 0x30);
+    uint16_t d = 0x18u + (((inst >> 4) & 0x3) << 1);
+    uint16_t Rd = avr->read_word(d), x;
+    x = Rd + K;
+    avr->sreg.V = ((~Rd & x) & 0x8000) != 0;
+    avr->sreg.N = (x & 0x8000) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = ((~x & Rd) & 0x8000) != 0;
+    avr->write_word(d, x);
+    return 2;
+}
+
+template<class CPU>
+static int do_AND(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rr & Rd;
+    avr->sreg.V = 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_ANDI(CPU *avr, uint16_t inst)
+{
+    // ----KKKKddddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 4) & 0xf0);
+    uint16_t d = 16 + ((inst >> 4) & 0xf);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = Rd & K;
+    avr->sreg.S = (x & 0x80) != 0;
+    avr->sreg.V = 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_ASR(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = (int8_t)Rd >> 1;
+    avr->sreg.C = Rd & 0x01;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.V = avr->sreg.N ^ avr->sreg.C;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_BCLR(CPU *avr, uint16_t inst)
+{
+    // ---------sss----
+    uint16_t t = ((inst >> 4) & 0x7);
+    avr->sreg.bits &= ~(1 << t);
+    return 1;
+}
+
+template<class CPU>
+static int do_BLD(CPU *avr, uint16_t inst)
+{
+    // -------ddddd-bbb
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t b = (inst & 0x7);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = (Rd & ~(1 << b)) | ((avr->sreg.T ? 1 : 0) << b);
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_BRBC(CPU *avr, uint16_t inst)
+{
+    // ------kkkkkkksss
+    uint16_t k = ((inst >> 3) & 0x7f);
+    uint16_t t = (inst & 0x7);
+    if((avr->sreg.bits & (1 << t)) == 0) {
+        avr->pc += (int8_t)(k << 1) >> 1;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_BRBS(CPU *avr, uint16_t inst)
+{
+    // ------kkkkkkksss
+    uint16_t k = ((inst >> 3) & 0x7f);
+    uint16_t t = (inst & 0x7);
+    if(avr->sreg.bits & (1 << t)) {
+        avr->pc += (int8_t)(k << 1) >> 1;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_BREAK(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_BSET(CPU *avr, uint16_t inst)
+{
+    // ---------sss----
+    uint16_t t = ((inst >> 4) & 0x7);
+    avr->sreg.bits |= 1 << t;
+    return 1;
+}
+
+template<class CPU>
+static int do_BST(CPU *avr, uint16_t inst)
+{
+    // -------ddddd-bbb
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t b = (inst & 0x7);
+    uint8_t Rd;
+    Rd = avr->read_byte(d);
+    avr->sreg.T = ((Rd & (1 << b)) != 0);
+    return 1;
+}
+
+template<class CPU>
+static int do_CALL(CPU *avr, uint16_t inst)
+{
+    // -------kkkkk---k
+    uint16_t k = (inst & 0x1) | ((inst >> 3) & 0x3e);
+    k = k << 16 | avr->flash.words[avr->pc++];
+    avr->push_word(avr->pc);
+    avr->pc = k;
+    avr->edge();
+    avr->called(avr->pc, false);
+    return 4;
+}
+
+template<class CPU>
+static int do_CBI(CPU *avr, uint16_t inst)
+{
+    // --------AAAAAbbb
+    uint16_t A = ((inst >> 3) & 0x1f) + 0x20;
+    uint16_t b = (inst & 0x7);
+    uint8_t RA = avr->read_byte(A);
+    RA &= ~(1 << b);
+    avr->write_byte(A, RA);
+    return 2;
+}
+
+template<class CPU>
+static int do_COM(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = ~Rd;
+    avr->sreg.V = 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = 1;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_CP(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    avr->compare(d, Rd, Rr, false);
+    x = Rd - Rr;
+    avr->sreg.H = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~Rr & ~x) | (~Rd & Rr & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x80) != 0;
+    return 1;
+}
+
+template<class CPU>
+static int do_CPC(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    avr->compare(d, Rd, Rr, true);
+    x = Rd - Rr - (avr->sreg.C ? 1 : 0);
+    avr->sreg.H = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~Rr & ~x) | (~Rd & Rr & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z &= x == 0;
+    avr->sreg.C = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x80) != 0;
+    return 1;
+}
+
+template<class CPU>
+static int do_CPI(CPU *avr, uint16_t inst)
+{
+    // ----KKKKddddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 4) & 0xf0);
+    uint16_t d = 16 + ((inst >> 4) & 0xf);
+    uint8_t Rd = avr->read_byte(d), x;
+    avr->compare(d, Rd, K, false);
+    x = Rd - K;
+    avr->sreg.H = (((~Rd & K) | (K & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~K & ~x) | (~Rd & K & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = (((~Rd & K) | (K & x) | (x & ~Rd)) & 0x80) != 0;
+    return 1;
+}
+
+template<class CPU>
+static int do_CPSE(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d);
+    avr->compare(d, Rd, Rr, false);
+    if(Rd == Rr) {
+        if(extended_inst(avr->flash.words[avr->pc])) {
+            avr->pc += 2;
+            avr->edge();
+            return 3;
+        }
+        avr->pc++;
+        avr->edge();
+        return 2;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_DEC(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d);
+    Rd--;
+    avr->sreg.V = Rd == 0x7f;
+    avr->sreg.N = (Rd & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = Rd == 0;
+    avr->write_byte(d, Rd);
+    return 1;
+}
+
+template<class CPU>
+static int do_DES(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_EICALL(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_EIJMP(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_ELPM_1(CPU *avr, uint16_t inst)
+{
+    uint32_t Z = avr->read_byte(AVR_REG_RAMPZ);
+    Z = Z << 16 | avr->read_word(AVR_REG_Z);
+    avr->write_byte(0, avr->flash.bytes[Z & (FLASH_SIZE_BYTES - 1)]);
+    return 3;
+}
+
+template<class CPU>
+static int do_ELPM_2(CPU *avr, uint16_t inst)
+{
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint32_t Z = avr->read_byte(AVR_REG_RAMPZ);
+    Z = Z << 16 | avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->flash.bytes[Z & (FLASH_SIZE_BYTES - 1)]);
+    return 3;
+}
+
+template<class CPU>
+static int do_ELPM_3(CPU *avr, uint16_t inst)
+{
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint32_t Z = avr->read_byte(AVR_REG_RAMPZ);
+    Z = Z << 16 | avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->flash.bytes[Z & (FLASH_SIZE_BYTES - 1)]);
+    Z++;
+    avr->write_word(AVR_REG_Z, Z & 0xffff);
+    avr->write_byte(AVR_REG_RAMPZ, Z >> 16);
+    return 3;
+}
+
+template<class CPU>
+static int do_EOR(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rd ^= Rr;
+    avr->sreg.S = (x & 0x80) != 0;
+    avr->sreg.V = 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_FMUL(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_FMULS(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_FMULSU(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_ICALL(CPU *avr, uint16_t inst)
+{
+    avr->push_word(avr->pc);
+    avr->pc = avr->read_word(AVR_REG_Z);
+    avr->edge();
+    avr->called(avr->pc, false);
+    return 3;
+}
+
+template<class CPU>
+static int do_IJMP(CPU *avr, uint16_t inst)
+{
+    avr->pc = avr->read_word(AVR_REG_Z);
+    avr->edge();
+    avr->returned();
+    return 2;
+}
+
+template<class CPU>
+static int do_ILLEGAL(CPU *avr, uint16_t inst)
+{
+    avr->illegalinst(inst);
+    return 0;
+}
+
+template<class CPU>
+static int do_IN(CPU *avr, uint16_t inst)
+{
+    // -----AAdddddAAAA
+    uint16_t A = ((inst & 0xf) | ((inst >> 5) & 0x30)) + 0x20;
+    uint16_t d = ((inst >> 4) & 0x1f);
+    avr->write_byte(d, avr->read_byte(A));
+    return 1;
+}
+
+template<class CPU>
+static int do_INC(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d);
+    Rd++;
+    avr->sreg.V = Rd == 0x80;
+    avr->sreg.N = (Rd & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = Rd == 0;
+    avr->write_byte(d, Rd);
+    return 1;
+}
+
+template<class CPU>
+static int do_JMP(CPU *avr, uint16_t inst)
+{
+    // -------kkkkk---k
+    uint16_t k = (inst & 0x1) | ((inst >> 3) & 0x3e);
+    k = k << 16 | avr->flash.words[avr->pc++];
+    avr->pc = k;
+    avr->edge();
+    return 3;
+}
+
+template<class CPU>
+static int do_LD_X1(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t X = avr->read_word(AVR_REG_X);
+    avr->write_byte(d, avr->read_byte(X));
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_X2(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t X = avr->read_word(AVR_REG_X);
+    avr->write_byte(d, avr->read_byte(X++));
+    avr->write_word(AVR_REG_X, X);
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_X3(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t X = avr->read_word(AVR_REG_X);
+    avr->write_byte(d, avr->read_byte(--X));
+    avr->write_word(AVR_REG_X, X);
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_Y2(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Y = avr->read_word(AVR_REG_Y);
+    avr->write_byte(d, avr->read_byte(Y++));
+    avr->write_word(AVR_REG_Y, Y);
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_Y3(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Y = avr->read_word(AVR_REG_Y);
+    avr->write_byte(d, avr->read_byte(--Y));
+    avr->write_word(AVR_REG_Y, Y);
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_Y4(CPU *avr, uint16_t inst)
+{
+    // --q-qq-ddddd-qqq
+    uint16_t q = (inst & 0x7) | ((inst >> 7) & 0x18) | ((inst >> 8) & 0x20);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Y = avr->read_word(AVR_REG_Y);
+    avr->write_byte(d, avr->read_byte(Y + q));
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_Z2(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->read_byte(Z++));
+    avr->write_word(AVR_REG_Z, Z);
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_Z3(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->read_byte(--Z));
+    avr->write_word(AVR_REG_Z, Z);
+    return 2;
+}
+
+template<class CPU>
+static int do_LD_Z4(CPU *avr, uint16_t inst)
+{
+    // --q-qq-ddddd-qqq
+    uint16_t q = (inst & 0x7) | ((inst >> 7) & 0x18) | ((inst >> 8) & 0x20);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->read_byte(Z + q));
+    return 2;
+}
+
+template<class CPU>
+static int do_LDI(CPU *avr, uint16_t inst)
+{
+    // ----KKKKddddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 4) & 0xf0);
+    uint16_t d = 16 + ((inst >> 4) & 0xf);
+    avr->write_byte(d, K);
+    return 1;
+}
+
+template<class CPU>
+static int do_LDS(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t k = avr->flash.words[avr->pc++];
+    avr->write_byte(d, avr->read_byte(k));
+    return 2;
+}
+
+template<class CPU>
+static int do_LPM_1(CPU *avr, uint16_t inst)
+{
+    // only ELPM reaches past the first 64K with RAMPZ
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(0, avr->flash.bytes[Z]);
+    return 3;
+}
+
+template<class CPU>
+static int do_LPM_2(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->flash.bytes[Z]);
+    return 3;
+}
+
+template<class CPU>
+static int do_LPM_3(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(d, avr->flash.bytes[Z++]);
+    avr->write_word(AVR_REG_Z, Z & 0xffff);
+    return 3;
+}
+
+template<class CPU>
+static int do_LSR(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = Rd >> 1;
+    avr->sreg.C = Rd & 0x01;
+    avr->sreg.N = 0;
+    avr->sreg.V = avr->sreg.N ^ avr->sreg.C;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_MOV(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    avr->write_byte(d, avr->read_byte(r));
+    return 1;
+}
+
+template<class CPU>
+static int do_MOVW(CPU *avr, uint16_t inst)
+{
+    // --------ddddrrrr
+    uint16_t d = ((inst >> 4) & 0xf) << 1;
+    uint16_t r = (inst & 0xf) << 1;
+    avr->write_word(d, avr->read_word(r));
+    return 1;
+}
+
+template<class CPU>
+static int do_MUL(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t x;
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d);
+    x = Rr * Rd;
+    avr->write_word(0, x);
+    avr->sreg.C = (x & 0x8000) != 0;
+    avr->sreg.Z = x == 0;
+    return 2;
+}
+
+template<class CPU>
+static int do_MULS(CPU *avr, uint16_t inst)
+{
+    // --------ddddrrrr
+    uint16_t d = ((inst >> 4) & 0xf);
+    uint16_t r = (inst & 0xf);
+    int16_t x;
+    int8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d);
+    x = Rr * Rd;
+    avr->write_word(0, x);
+    avr->sreg.C = (x & 0x8000) != 0;
+    avr->sreg.Z = x == 0;
+    return 2;
+}
+
+template<class CPU>
+static int do_MULSU(CPU *avr, uint16_t inst)
+{
+    // ---------ddd-rrr
+    uint16_t d = ((inst >> 4) & 0x7);
+    uint16_t r = (inst & 0x7);
+    int16_t x;
+    uint8_t Rr = avr->read_byte(r);
+    int8_t Rd = avr->read_byte(d);
+    x = Rr * Rd;
+    avr->write_word(0, x);
+    avr->sreg.C = (x & 0x8000) != 0;
+    avr->sreg.Z = x == 0;
+    return 2;
+}
+
+template<class CPU>
+static int do_NEG(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = -Rd;
+    avr->sreg.H = ((x | Rd) & 0x08) != 0;
+    avr->sreg.V = x == 0x80;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = x != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_NOP(CPU *avr, uint16_t inst)
+{
+    return 1;
+}
+
+template<class CPU>
+static int do_OR(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rd | Rr;
+    avr->sreg.V = 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_ORI(CPU *avr, uint16_t inst)
+{
+    // ----KKKKddddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 4) & 0xf0);
+    uint16_t d = 16 + ((inst >> 4) & 0xf);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = Rd | K;
+    avr->sreg.S = (x & 0x80) != 0;
+    avr->sreg.V = 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.Z = x == 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_OUT(CPU *avr, uint16_t inst)
+{
+    // -----AArrrrrAAAA
+    uint16_t A = ((inst & 0xf) | ((inst >> 5) & 0x30)) + 0x20;
+    uint16_t r = ((inst >> 4) & 0x1f);
+    avr->write_byte(A, avr->read_byte(r));
+    return 1;
+}
+
+template<class CPU>
+static int do_POP(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    avr->write_byte(d, avr->pop_byte());
+    return 2;
+}
+
+template<class CPU>
+static int do_PUSH(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    avr->push_byte(avr->read_byte(r));
+    return 2;
+}
+
+template<class CPU>
+static int do_RCALL(CPU *avr, uint16_t inst)
+{
+    // ----kkkkkkkkkkkk
+    uint16_t k = (inst & 0xfff);
+    avr->push_word(avr->pc);
+    avr->pc += (int16_t)(k << 4) >> 4;
+    avr->edge();
+    avr->called(avr->pc, false);
+    return 3;
+}
+
+template<class CPU>
+static int do_RET(CPU *avr, uint16_t inst)
+{
+    avr->pc = avr->pop_word();
+    avr->edge();
+    avr->returned();
+    return 4;
+}
+
+template<class CPU>
+static int do_RETI(CPU *avr, uint16_t inst)
+{
+    avr->pc = avr->pop_word();
+    avr->sreg.I = 1;
+    avr->edge();
+    avr->returned();
+    return 4;
+}
+
+template<class CPU>
+static int do_RJMP(CPU *avr, uint16_t inst)
+{
+    // ----kkkkkkkkkkkk
+    uint16_t k = (inst & 0xfff);
+    avr->pc += (int16_t)(k << 4) >> 4;
+    avr->edge();
+    return 2;
+}
+
+template<class CPU>
+static int do_ROR(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = (Rd >> 1) | (avr->sreg.C ? 0x80 : 0);
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.V = avr->sreg.N ^ avr->sreg.C;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = Rd & 0x01;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_SBC(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rd - Rr - (avr->sreg.C ? 1 : 0);
+    avr->sreg.H = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~Rr & ~x) | (~Rd & Rr & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z &= x == 0;
+    avr->sreg.C = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x80) != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_SBCI(CPU *avr, uint16_t inst)
+{
+    // ----KKKKddddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 4) & 0xf0);
+    uint16_t d = 16 + ((inst >> 4) & 0xf);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = Rd - K - (avr->sreg.C ? 1 : 0);
+    avr->sreg.H = (((~Rd & K) | (K & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~K & ~x) | (~Rd & K & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z &= x == 0;
+    avr->sreg.C = (((~Rd & K) | (K & x) | (x & ~Rd)) & 0x80) != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_SBI(CPU *avr, uint16_t inst)
+{
+    // --------AAAAAbbb
+    uint16_t A = ((inst >> 3) & 0x1f) + 0x20;
+    uint16_t b = (inst & 0x7);
+    uint8_t RA = avr->read_byte(A);
+    RA |= (1 << b);
+    avr->write_byte(A, RA);
+    return 2;
+}
+
+template<class CPU>
+static int do_SBIC(CPU *avr, uint16_t inst)
+{
+    // --------AAAAAbbb
+    uint16_t A = ((inst >> 3) & 0x1f) + 0x20;
+    uint16_t b = (inst & 0x7);
+    uint8_t RA = avr->read_byte(A);
+    if((RA & (1 << b)) == 0) {
+        if(extended_inst(avr->flash.words[avr->pc])) {
+            avr->pc += 2;
+            avr->edge();
+            return 3;
+        }
+        avr->pc++;
+        avr->edge();
+        return 2;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_SBIS(CPU *avr, uint16_t inst)
+{
+    // --------AAAAAbbb
+    uint16_t A = ((inst >> 3) & 0x1f) + 0x20;
+    uint16_t b = (inst & 0x7);
+    uint8_t RA = avr->read_byte(A);
+    if((RA & (1 << b)) != 0) {
+        if(extended_inst(avr->flash.words[avr->pc])) {
+            avr->pc += 2;
+            avr->edge();
+            return 3;
+        }
+        avr->pc++;
+        avr->edge();
+        return 2;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_SBIW(CPU *avr, uint16_t inst)
+{
+    // --------KKddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 2) & 0x30);
+    uint16_t d = 0x18u + (((inst >> 4) & 0x3) << 1);
+    uint16_t Wd = avr->read_word(d), x;
+    x = Wd - K;
+    avr->sreg.V = ((Wd & ~x) & 0x8000) != 0;
+    avr->sreg.N = (x & 0x8000) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = ((x & ~Wd) & 0x8000) != 0;
+    avr->write_word(d, x);
+    return 2;
+}
+
+template<class CPU>
+static int do_SBRC(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr-bbb
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t b = (inst & 0x7);
+    uint8_t Rr = avr->read_byte(r);
+    if((Rr & (1 << b)) == 0) {
+        if(extended_inst(avr->flash.words[avr->pc])) {
+            avr->pc += 2;
+            avr->edge();
+            return 3;
+        }
+        avr->pc++;
+        avr->edge();
+        return 2;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_SBRS(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr-bbb
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t b = (inst & 0x7);
+    uint8_t Rr = avr->read_byte(r);
+    if(Rr & (1 << b)) {
+        if(extended_inst(avr->flash.words[avr->pc])) {
+            avr->pc += 2;
+            avr->edge();
+            return 3;
+        }
+        avr->pc++;
+        avr->edge();
+        return 2;
+    }
+    avr->edge();
+    return 1;
+}
+
+template<class CPU>
+static int do_SLEEP(CPU *avr, uint16_t inst)
+{
+    // every sleep mode looks the same here: nothing runs until an interrupt
+    if(avr->read_byte(AVR_REG_MCUCR) & AVR_MCUCR_SE) {
+        avr->sleeping = true;
+    }
+    return 1;
+}
+
+template<class CPU>
+static int do_SPM2_1(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_SPM2_2(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+template<class CPU>
+static int do_ST_X1(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t X = avr->read_word(AVR_REG_X);
+    avr->write_byte(X, avr->read_byte(r));
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_X2(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t X = avr->read_word(AVR_REG_X);
+    avr->write_byte(X++, avr->read_byte(r));
+    avr->write_word(AVR_REG_X, X);
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_X3(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t X = avr->read_word(AVR_REG_X);
+    avr->write_byte(--X, avr->read_byte(r));
+    avr->write_word(AVR_REG_X, X);
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_Y2(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t Y = avr->read_word(AVR_REG_Y);
+    avr->write_byte(Y++, avr->read_byte(r));
+    avr->write_word(AVR_REG_Y, Y);
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_Y3(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t Y = avr->read_word(AVR_REG_Y);
+    avr->write_byte(--Y, avr->read_byte(r));
+    avr->write_word(AVR_REG_Y, Y);
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_Y4(CPU *avr, uint16_t inst)
+{
+    // --q-qq-rrrrr-qqq
+    uint16_t q = (inst & 0x7) | ((inst >> 7) & 0x18) | ((inst >> 8) & 0x20);
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t Y = avr->read_word(AVR_REG_Y);
+    avr->write_byte(Y + q, avr->read_byte(r));
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_Z2(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(Z++, avr->read_byte(r));
+    avr->write_word(AVR_REG_Z, Z);
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_Z3(CPU *avr, uint16_t inst)
+{
+    // -------rrrrr----
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(--Z, avr->read_byte(r));
+    avr->write_word(AVR_REG_Z, Z);
+    return 2;
+}
+
+template<class CPU>
+static int do_ST_Z4(CPU *avr, uint16_t inst)
+{
+    // --q-qq-rrrrr-qqq
+    uint16_t q = (inst & 0x7) | ((inst >> 7) & 0x18) | ((inst >> 8) & 0x20);
+    uint16_t r = ((inst >> 4) & 0x1f);
+    uint16_t Z = avr->read_word(AVR_REG_Z);
+    avr->write_byte(Z + q, avr->read_byte(r));
+    return 2;
+}
+
+template<class CPU>
+static int do_STS(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint16_t k = avr->flash.words[avr->pc++];
+    avr->write_byte(k, avr->read_byte(d));
+    return 2;
+}
+
+template<class CPU>
+static int do_SUB(CPU *avr, uint16_t inst)
+{
+    // ------rdddddrrrr
+    uint16_t r = (inst & 0xf) | ((inst >> 5) & 0x10);
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rr = avr->read_byte(r), Rd = avr->read_byte(d), x;
+    x = Rd - Rr;
+    avr->sreg.H = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~Rr & ~x) | (~Rd & Rr & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = (((~Rd & Rr) | (Rr & x) | (x & ~Rd)) & 0x80) != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_SUBI(CPU *avr, uint16_t inst)
+{
+    // ----KKKKddddKKKK
+    uint16_t K = (inst & 0xf) | ((inst >> 4) & 0xf0);
+    uint16_t d = 16 + ((inst >> 4) & 0xf);
+    uint8_t Rd = avr->read_byte(d), x;
+    x = Rd - K;
+    avr->sreg.H = (((~Rd & K) | (K & x) | (x & ~Rd)) & 0x08) != 0;
+    avr->sreg.V = (((Rd & ~K & ~x) | (~Rd & K & x)) & 0x80) != 0;
+    avr->sreg.N = (x & 0x80) != 0;
+    avr->sreg.S = avr->sreg.N ^ avr->sreg.V;
+    avr->sreg.Z = x == 0;
+    avr->sreg.C = (((~Rd & K) | (K & x) | (x & ~Rd)) & 0x80) != 0;
+    avr->write_byte(d, x);
+    return 1;
+}
+
+template<class CPU>
+static int do_SWAP(CPU *avr, uint16_t inst)
+{
+    // -------ddddd----
+    uint16_t d = ((inst >> 4) & 0x1f);
+    uint8_t Rd = avr->read_byte(d);
+    Rd = (Rd << 4) | (Rd >> 4);
+    avr->write_byte(d, Rd);
+    return 1;
+}
+
+template<class CPU>
+static int do_WDR(CPU *avr, uint16_t inst)
+{
+    avr->unimplemented(__FUNCTION__);
+    return 0;
+}
+
+
+#endif
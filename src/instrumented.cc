@@ -0,0 +1,13 @@
+// instrumented.cc
+
+#include "engine.hh"
+#include "instrumented.hh"
+
+Instrumented::instruction Instrumented::instructions[INSTRUCTION_SPACE] = {
+#include "instruction_handler.hh"
+};
+
+void Instrumented::process()
+{
+    executed = step(this);
+}
@@ -0,0 +1,157 @@
+// instrumented.hh
+
+#ifndef AVRE_INSTRUMENTED_HH
+#define AVRE_INSTRUMENTED_HH
+
+#include "avr.hh"
+
+// the core with what AVR leaves out of its loop: the trace, the profile,
+// the call graph, watchpoints on SRAM and on SP as pushes and pops move
+// it, and the interrupt and I/O access counts of metrics. As for
+// Engine<Hooks>, the instruction handlers are compiled again against this
+// class (in instrumented.cc), so the members below are what they call;
+// it is only built when one of these is asked for
+class Instrumented : public AVR
+{
+    friend class AVR;
+
+protected:
+    typedef int (*instruction)(Instrumented *, uint16_t);
+
+    static instruction instructions[INSTRUCTION_SPACE];
+
+public:
+    Instrumented(const char *fn, const char *tp)
+        : AVR(fn, tp)
+    {
+    }
+
+    Instrumented(const FlashImage &image)
+        : AVR(image)
+    {
+    }
+
+    virtual void process();
+
+    void before_exec(uint16_t at)
+    {
+        if(trace != NULL)
+        {
+            trace->step(at, cycle);
+        }
+    }
+
+    void after_exec(uint16_t at, int taken)
+    {
+        if(profile != NULL)
+        {
+            profile->count(at, taken);
+        }
+    }
+
+    void before_irq(int num)
+    {
+        Metrics::count(metrics->irqs);
+    }
+
+    uint8_t read_byte(uint16_t addr)
+    {
+        if(addr < REGS_SIZE_BYTES)
+        {
+            if(read_handler[addr])
+            {
+                Metrics::count(metrics->io_reads[addr]);
+            }
+        }
+        else if(watch_pages[addr >> SRAM_PAGE_SHIFT])
+        {
+            watch_access(addr, sram.bytes[addr], WATCH_READ);
+        }
+        return AVR::read_byte(addr);
+    }
+
+    void write_byte(uint16_t addr, uint8_t data)
+    {
+        if(addr < REGS_SIZE_BYTES)
+        {
+            if(write_handler[addr])
+            {
+                Metrics::count(metrics->io_writes[addr]);
+            }
+        }
+        else
+        {
+            if(watch_pages[addr >> SRAM_PAGE_SHIFT])
+            {
+                watch_access(addr, data, WATCH_WRITE);
+            }
+            if(trace != NULL && trace->writes)
+            {
+                trace->write(addr, data);
+            }
+        }
+        AVR::write_byte(addr, data);
+    }
+
+    uint16_t read_word(uint16_t addr)
+    {
+        return (uint16_t)read_byte(addr) | (((uint16_t)read_byte(addr + 1)) << 8);
+    }
+
+    void write_word(uint16_t addr, uint16_t data)
+    {
+        write_byte(addr, data & 0xff);
+        write_byte(addr + 1, data >> 8);
+    }
+
+    void set_sp(uint16_t value)
+    {
+        AVR::set_sp(value);
+        if(watch_sp)
+        {
+            watch_sp_write();
+        }
+    }
+
+    uint8_t pop_byte()
+    {
+        set_sp(sp + 1);
+        return read_byte(sp);
+    }
+
+    void push_byte(uint8_t data)
+    {
+        write_byte(sp, data);
+        set_sp(sp - 1);
+    }
+
+    uint16_t pop_word()
+    {
+        set_sp(sp + 2);
+        return read_word(sp - 1);
+    }
+
+    void push_word(uint16_t data)
+    {
+        write_word(sp - 1, data);
+        set_sp(sp - 2);
+    }
+
+    void called(uint16_t target, bool irq)
+    {
+        if(callgraph != NULL)
+        {
+            callgraph->call(target, sp, cycle, irq);
+        }
+    }
+
+    void returned()
+    {
+        if(callgraph != NULL)
+        {
+            callgraph->ret(sp, cycle);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,240 @@
+// journal.cc
+
+#include <cstdlib>
+#include <cstring>
+
+#include "journal.hh"
+#include "usart.hh"
+
+Journal::Journal(AVR *_avr, const char *fn, bool replay)
+    : avr(_avr), f(NULL), last(0), pos(0), replaying(replay)
+{
+    if(replaying)
+    {
+        load(fn);
+        return;
+    }
+
+    f = fopen(fn, "wb");
+    if(f == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    fwrite(JOURNAL_MAGIC, 1, JOURNAL_MAGIC_SIZE, f);
+    fflush(f);
+}
+
+Journal::~Journal()
+{
+    if(f != NULL)
+    {
+        fclose(f);
+    }
+}
+
+void Journal::load(const char *fn)
+{
+    char magic[JOURNAL_MAGIC_SIZE];
+    JournalEvent event;
+    uint64_t delta;
+    unsigned shift;
+    FILE *in;
+    int ch;
+
+    in = fopen(fn, "rb");
+    if(in == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    if(fread(magic, 1, JOURNAL_MAGIC_SIZE, in) != JOURNAL_MAGIC_SIZE || memcmp(magic, JOURNAL_MAGIC, JOURNAL_MAGIC_SIZE) != 0)
+    {
+        fprintf(stderr, "%s: not a journal\n", fn);
+        exit(1);
+    }
+
+    while((ch = fgetc(in)) != EOF)
+    {
+        delta = 0;
+        shift = 0;
+        while(ch & 0x80)
+        {
+            delta |= (uint64_t)(ch & 0x7f) << shift;
+            shift += 7;
+            if(64 <= shift || (ch = fgetc(in)) == EOF)
+            {
+                break;
+            }
+        }
+        delta |= (uint64_t)(ch & 0x7f) << shift;
+        last += delta;
+
+        event.cycle = last;
+        ch = fgetc(in);
+        event.channel = ch >> 1;
+        event.kind = ch & 1;
+        ch = fgetc(in);
+        if(ch == EOF)
+        {
+            // a record cut short by a killed recording
+            fprintf(stderr, "%s: truncated after %zu events\n", fn, events.size());
+            break;
+        }
+        event.data = ch;
+        events.push_back(event);
+    }
+    fclose(in);
+}
+
+void Journal::attach(Machine *machine)
+{
+    USART *usart;
+    uint8_t channel = 0;
+
+    for(Module *module : machine->peripherals())
+    {
+        usart = dynamic_cast<USART *>(module);
+        if(usart == NULL)
+        {
+            continue;
+        }
+        if(replaying)
+        {
+            usart->attach(new ReplayBackend(this, channel));
+        }
+        else
+        {
+            usart->attach(new RecordBackend(usart->detach(), this, channel));
+        }
+        channel++;
+    }
+}
+
+void Journal::record(uint8_t channel, uint8_t kind, uint8_t data)
+{
+    uint64_t delta = avr->cycle - last;
+    JournalEvent event = {avr->cycle, channel, kind, data};
+
+    while(0x80 <= delta)
+    {
+        fputc((delta & 0x7f) | 0x80, f);
+        delta >>= 7;
+    }
+    fputc(delta, f);
+    fputc(channel << 1 | kind, f);
+    fputc(data, f);
+    // events are rare next to instructions; keep the file complete in
+    // case the session ends with a crash or a kill
+    fflush(f);
+    last = avr->cycle;
+
+    // kept for going back in time
+    events.push_back(event);
+    pos = events.size();
+}
+
+int Journal::replay(uint8_t channel, uint8_t kind, uint8_t *data)
+{
+    if(finished())
+    {
+        return 0;
+    }
+
+    JournalEvent &event = events[pos];
+    if(event.cycle < avr->cycle)
+    {
+        fprintf(stderr, "replay diverged: event %zu due at cycle %llu was not taken\n", pos, (unsigned long long)event.cycle);
+        exit(1);
+    }
+    if(avr->cycle < event.cycle || event.channel != channel || event.kind != kind)
+    {
+        return 0;
+    }
+    if(kind == JOURNAL_TX && *data != event.data)
+    {
+        fprintf(stderr, "replay diverged: sent %02x instead of %02x at cycle %llu\n", *data, event.data, (unsigned long long)event.cycle);
+        exit(1);
+    }
+    *data = event.data;
+    pos++;
+    return 1;
+}
+
+size_t Journal::size() const
+{
+    return events.size();
+}
+
+size_t Journal::position() const
+{
+    return pos;
+}
+
+void Journal::seek(size_t _pos)
+{
+    pos = _pos;
+}
+
+bool Journal::finished() const
+{
+    return events.size() <= pos;
+}
+
+RecordBackend::RecordBackend(Backend *_backend, Journal *_journal, uint8_t _channel)
+    : backend(_backend), journal(_journal), channel(_channel)
+{
+}
+
+RecordBackend::~RecordBackend()
+{
+    delete backend;
+}
+
+int RecordBackend::poll_read(uint8_t *data)
+{
+    if(!journal->finished())
+    {
+        // rewound; replay up to where the recording stands
+        return journal->replay(channel, JOURNAL_RX, data);
+    }
+    if(backend->poll_read(data))
+    {
+        journal->record(channel, JOURNAL_RX, *data);
+        return 1;
+    }
+    return 0;
+}
+
+int RecordBackend::poll_write(uint8_t data)
+{
+    if(!journal->finished())
+    {
+        return journal->replay(channel, JOURNAL_TX, &data);
+    }
+    if(backend->poll_write(data))
+    {
+        journal->record(channel, JOURNAL_TX, data);
+        return 1;
+    }
+    return 0;
+}
+
+ReplayBackend::ReplayBackend(Journal *_journal, uint8_t _channel)
+    : journal(_journal), channel(_channel)
+{
+}
+
+ReplayBackend::~ReplayBackend()
+{
+}
+
+int ReplayBackend::poll_read(uint8_t *data)
+{
+    return journal->replay(channel, JOURNAL_RX, data);
+}
+
+int ReplayBackend::poll_write(uint8_t data)
+{
+    return journal->replay(channel, JOURNAL_TX, &data);
+}
@@ -0,0 +1,99 @@
+// journal.hh
+
+#ifndef AVRE_JOURNAL_HH
+#define AVRE_JOURNAL_HH
+
+#include <cstdio>
+#include <vector>
+
+#include "backend.hh"
+#include "machine.hh"
+
+// file layout: JOURNAL_MAGIC, then one record per event:
+//   cycles since the previous event, LEB128
+//   channel << 1 | kind, one byte
+//   the byte received or sent
+#define JOURNAL_MAGIC "AVREJNL1"
+#define JOURNAL_MAGIC_SIZE (8u)
+
+#define JOURNAL_RX (0u)
+#define JOURNAL_TX (1u)
+
+struct JournalEvent
+{
+    uint64_t cycle;
+    uint8_t channel;
+    uint8_t kind;
+    uint8_t data;
+};
+
+// external USART events stamped with the cycle at which the firmware saw
+// them; a replay hands each one over at exactly the same cycle, which is
+// all it takes for the run to be repeated instruction for instruction
+class Journal
+{
+protected:
+    AVR *avr;
+    FILE *f;
+    uint64_t last;
+    std::vector<JournalEvent> events;
+    size_t pos;
+
+    void load(const char *fn);
+
+public:
+    const bool replaying;
+
+    Journal(AVR *_avr, const char *fn, bool replay);
+    ~Journal();
+
+    // wraps the backend of every USART, numbered in board order
+    void attach(Machine *machine);
+
+    void record(uint8_t channel, uint8_t kind, uint8_t data);
+    // 1 when the next event is this one and is due
+    int replay(uint8_t channel, uint8_t kind, uint8_t *data);
+
+    size_t size() const;
+    bool finished() const;
+
+    // index of the next event to replay; a recording that is moved back
+    // replays what it already has before it records again
+    size_t position() const;
+    void seek(size_t _pos);
+};
+
+// passes through to the real backend and records what got through, unless
+// the journal was rewound
+class RecordBackend : public Backend
+{
+protected:
+    Backend *backend;
+    Journal *journal;
+    uint8_t channel;
+
+public:
+    RecordBackend(Backend *_backend, Journal *_journal, uint8_t _channel);
+    virtual ~RecordBackend();
+
+    virtual int poll_read(uint8_t *data);
+    virtual int poll_write(uint8_t data);
+};
+
+// takes every transfer from the journal and never touches a descriptor;
+// a written byte that differs from the recorded one is a divergence
+class ReplayBackend : public Backend
+{
+protected:
+    Journal *journal;
+    uint8_t channel;
+
+public:
+    ReplayBackend(Journal *_journal, uint8_t _channel);
+    virtual ~ReplayBackend();
+
+    virtual int poll_read(uint8_t *data);
+    virtual int poll_write(uint8_t data);
+};
+
+#endif
@@ -0,0 +1,87 @@
+// libfuzzer.cc
+
+#ifdef AVRE_LIBFUZZER
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "fuzz.hh"
+
+// libFuzzer reads these 8-bit counters as its coverage feedback
+extern "C" void __sanitizer_cov_8bit_counters_init(uint8_t *start, uint8_t *stop);
+
+// and takes the guest's comparisons as hints for its value dictionary
+extern "C" void __sanitizer_cov_trace_cmp1(uint8_t a, uint8_t b);
+extern "C" void __sanitizer_cov_trace_cmp2(uint16_t a, uint16_t b);
+extern "C" void __sanitizer_cov_trace_cmp4(uint32_t a, uint32_t b);
+
+static FuzzTarget *target;
+
+static const char *env(const char *name, const char *def)
+{
+    const char *value = getenv(name);
+    return value == NULL ? def : value;
+}
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+    const char *fw;
+    Machine *machine;
+
+    fw = getenv("AVRE_FIRMWARE");
+    if(fw == NULL)
+    {
+        fprintf(stderr, "AVRE_FIRMWARE is not set\n");
+        exit(1);
+    }
+    machine = new Machine(new AVR(fw, env("AVRE_TYPE", "ihex")), getenv("AVRE_BOARD"), true);
+    target = new FuzzTarget(machine, env("AVRE_USART", "usart0"));
+    target->stop.cycles = strtoull(env("AVRE_CYCLES", "1000000"), NULL, 0);
+    target->boot(strtol(env("AVRE_BOOT_PC", "-1"), NULL, 0), target->stop.cycles);
+
+    __sanitizer_cov_8bit_counters_init(Coverage::map(), Coverage::map() + COVERAGE_MAP_SIZE);
+    return 0;
+}
+
+#ifdef AVRE_CMPLOG
+static void trace_compares()
+{
+    CmpLogRing *log = CmpLog::ring();
+    uint32_t i;
+
+    i = log->head < CMPLOG_ENTRIES ? 0 : log->head - CMPLOG_ENTRIES;
+    for(; i != log->head; i++)
+    {
+        CmpLogEntry &e = log->entries[i % CMPLOG_ENTRIES];
+        switch(e.size)
+        {
+        case 1:
+            __sanitizer_cov_trace_cmp1(e.a, e.b);
+            break;
+        case 2:
+            __sanitizer_cov_trace_cmp2(e.a, e.b);
+            break;
+        default:
+            __sanitizer_cov_trace_cmp4(e.a, e.b);
+            break;
+        }
+    }
+}
+#endif
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    StopReason reason;
+
+    reason = target->execute(data, size);
+#ifdef AVRE_CMPLOG
+    trace_compares();
+#endif
+    if(reason == STOP_FAULT)
+    {
+        abort();
+    }
+    return 0;
+}
+
+#endif
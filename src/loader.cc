@@ -2,14 +2,35 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include "avr.hh"
+#include "elf.hh"
+#include "image.hh"
 
-void AVR::load_elf(const char *fn)
+void FlashImage::load_elf(const char *fn)
 {
+    ElfFile elf(fn);
+
+    // program headers carry load addresses, which is where .data's
+    // initializers sit in flash right after .text
+    for(unsigned i = 0; i < elf.header().e_phnum; i++)
+    {
+        const Elf32_Phdr &ph = elf.segment(i);
+        if(ph.p_type != PT_LOAD || ph.p_filesz == 0 || ELF_AVR_DATA_BASE <= ph.p_paddr)
+        {
+            continue;
+        }
+        if(FLASH_SIZE_BYTES < ph.p_paddr + ph.p_filesz)
+        {
+            fprintf(stderr, "%s: address out of range\n", fn);
+            exit(1);
+        }
+        memcpy(flash->bytes + ph.p_paddr, elf.at(ph.p_offset, ph.p_filesz), ph.p_filesz);
+    }
 }
 
-void AVR::load_ihex(const char *fn)
+void FlashImage::load_ihex(const char *fn)
 {
     unsigned int size, addr, type, byte, checksum;
     int i;
@@ -63,7 +84,7 @@ void AVR::load_ihex(const char *fn)
             checksum += byte;
             if(tmp[7] == '0')
             {
-                flash.bytes[addr + i] = byte;
+                flash->bytes[addr + i] = byte;
             }
         }
         free(ptr);
@@ -89,7 +110,7 @@ void AVR::load_ihex(const char *fn)
     }
 }
 
-void AVR::load_bin(const char *fn)
+void FlashImage::load_bin(const char *fn)
 {
     unsigned int s, t;
     FILE *f;
@@ -103,14 +124,15 @@ void AVR::load_bin(const char *fn)
     s = 0;
     for(s = 0; s < FLASH_SIZE_BYTES && !feof(f); )
     {
-        if((t = fread(flash.bytes + s, 1, FLASH_SIZE_BYTES - s, f)) == 0)
+        if((t = fread(flash->bytes + s, 1, FLASH_SIZE_BYTES - s, f)) == 0)
         {
             perror(fn);
             exit(1);
         }
         s += t;
     }
-    if(!feof(f))
+    // a file of exactly the flash size has not seen its end yet
+    if(fgetc(f) != EOF)
     {
         fprintf(stderr, "%s: address out of range\n", fn);
         exit(1);
@@ -0,0 +1,237 @@
+// machine.cc
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include "condition.hh"
+#include "machine.hh"
+#include "usart.hh"
+
+// used when no board file is given; matches the ATmega128 layout
+static const char default_board[] =
+    "usart name=usart0 udr=0x2c ucsra=0x2b ucsrb=0x2a ucsrc=0x95 rxc=18 dre=19 txc=20 rx=fd:3 tx=fd:4\n"
+    "usart name=usart1 udr=0x9c ucsra=0x9b ucsrb=0x9a ucsrc=0x9d rxc=30 dre=31 txc=32 rx=fd:5 tx=fd:6\n";
+
+StopCondition::StopCondition()
+    : cycles(UINT64_MAX), instructions(UINT64_MAX), input(NULL), pc(-1), condition(NULL), output(NULL), sleep(true)
+{
+}
+
+const char *stop_reason_name(StopReason reason)
+{
+    switch(reason)
+    {
+    case STOP_NONE:
+        return "none";
+    case STOP_CYCLES:
+        return "cycles";
+    case STOP_FAULT:
+        return "fault";
+    case STOP_INPUT:
+        return "input";
+    case STOP_PC:
+        return "pc";
+    case STOP_INSTRUCTIONS:
+        return "instructions";
+    case STOP_OUTPUT:
+        return "output";
+    case STOP_SLEEP:
+        return "sleep";
+    case STOP_WATCH:
+        return "watch";
+    }
+    return "unknown";
+}
+
+Machine::Machine(AVR *_avr, const char *config, bool detached)
+    : arena(NULL), published(0), avr(_avr), steps(0), instructions(0)
+{
+    std::vector<ModuleConfig> configs;
+
+    if(config == NULL)
+    {
+        ModuleConfig::parse(default_board, "<default>", configs);
+    }
+    else
+    {
+        ModuleConfig::parse(ModuleConfig::read_file(config), config, configs);
+    }
+    for(size_t i = 0; detached && i < configs.size(); i++)
+    {
+        if(configs[i].type == "usart")
+        {
+            configs[i].set("rx", "null");
+            configs[i].set("tx", "null");
+        }
+    }
+    build(configs);
+}
+
+Machine::~Machine()
+{
+    for(size_t i = modules.size(); i-- != 0; )
+    {
+        modules[i]->~Module();
+    }
+    free(arena);
+    publish();
+    delete avr;
+}
+
+void Machine::build(const std::vector<ModuleConfig> &configs)
+{
+    std::vector<const ModuleFactory *> factories;
+    std::vector<size_t> offsets;
+    const ModuleFactory *factory;
+    size_t size = 0;
+
+    for(size_t i = 0; i < configs.size(); i++)
+    {
+        factory = ModuleRegistry::find(configs[i].type);
+        if(factory == NULL)
+        {
+            fprintf(stderr, "%s: unknown module -- '%s'\n", configs[i].where.c_str(), configs[i].type.c_str());
+            exit(1);
+        }
+        size = (size + factory->align - 1) / factory->align * factory->align;
+        factories.push_back(factory);
+        offsets.push_back(size);
+        size += factory->size;
+    }
+
+    // aligned_alloc wants a multiple of the alignment, and never zero
+    arena = (char *)aligned_alloc(alignof(std::max_align_t), (size / alignof(std::max_align_t) + 1) * alignof(std::max_align_t));
+    for(size_t i = 0; i < configs.size(); i++)
+    {
+        modules.push_back(factories[i]->create(arena + offsets[i], avr, configs[i]));
+        names.push_back(configs[i].name);
+        avr->attach(modules.back());
+    }
+}
+
+void Machine::initialize()
+{
+    avr->initialize();
+    for(size_t i = 0; i < modules.size(); i++)
+    {
+        modules[i]->initialize();
+    }
+}
+
+void Machine::process()
+{
+    avr->process();
+    if(avr->executed)
+    {
+        instructions++;
+    }
+    if(++steps % METRICS_BATCH == 0)
+    {
+        publish();
+    }
+    for(Module *module : modules)
+    {
+        module->process();
+    }
+}
+
+void Machine::publish()
+{
+    Metrics::count(avr->metrics->instructions, instructions - published);
+    published = instructions;
+    avr->publish();
+}
+
+StopReason Machine::run(const StopCondition &stop)
+{
+    uint64_t start = instructions, sent = 0;
+
+    if(stop.output != NULL)
+    {
+        sent = stop.output->sent();
+    }
+    while(true)
+    {
+        process();
+        if(avr->fault != AVR_FAULT_NONE)
+        {
+            return STOP_FAULT;
+        }
+        if(stop.cycles <= avr->cycle)
+        {
+            return STOP_CYCLES;
+        }
+        if(stop.input != NULL && stop.input->idle())
+        {
+            return STOP_INPUT;
+        }
+        if(avr->pc == stop.pc && (stop.condition == NULL || stop.condition->hit(avr)))
+        {
+            return STOP_PC;
+        }
+        if(stop.instructions <= instructions - start)
+        {
+            return STOP_INSTRUCTIONS;
+        }
+        if(stop.output != NULL && stop.output->sent() != sent)
+        {
+            sent = stop.output->sent();
+            if(stop.output->sent_ends_with(stop.pattern))
+            {
+                return STOP_OUTPUT;
+            }
+        }
+        if(stop.sleep && avr->sleeping && !avr->sreg.I)
+        {
+            return STOP_SLEEP;
+        }
+        if(avr->watched)
+        {
+            avr->watched = false;
+            return STOP_WATCH;
+        }
+    }
+}
+
+Module *Machine::find(const char *name)
+{
+    for(size_t i = 0; i < modules.size(); i++)
+    {
+        if(names[i] == name)
+        {
+            return modules[i];
+        }
+    }
+    return NULL;
+}
+
+USART *Machine::isolate(const char *name, Backend *backend)
+{
+    USART *usart = dynamic_cast<USART *>(find(name)), *other;
+
+    if(usart == NULL)
+    {
+        return NULL;
+    }
+    for(Module *module : modules)
+    {
+        other = dynamic_cast<USART *>(module);
+        if(other != NULL && other != usart)
+        {
+            other->attach(new NullBackend());
+        }
+    }
+    usart->attach(backend);
+    return usart;
+}
+
+const std::vector<Module *> &Machine::peripherals() const
+{
+    return modules;
+}
+
+const std::vector<std::string> &Machine::module_names() const
+{
+    return names;
+}
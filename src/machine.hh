@@ -0,0 +1,93 @@
+// machine.hh
+
+#ifndef AVRE_MACHINE_HH
+#define AVRE_MACHINE_HH
+
+#include <string>
+#include <vector>
+
+#include "avr.hh"
+#include "registry.hh"
+
+class Backend;
+class Condition;
+class USART;
+
+enum StopReason
+{
+    STOP_NONE,
+    STOP_CYCLES,
+    STOP_FAULT,
+    STOP_INPUT,
+    STOP_PC,
+    STOP_INSTRUCTIONS,
+    STOP_OUTPUT,
+    STOP_SLEEP,
+    STOP_WATCH,
+};
+
+struct StopCondition
+{
+    uint64_t cycles;
+    // counted from the start of the run
+    uint64_t instructions;
+    // stop once this USART's input is used up and the firmware waits for more
+    const USART *input;
+    // word address, -1 for none
+    int32_t pc;
+    // if set, the pc only stops the run when this holds
+    Condition *condition;
+    // stop once this USART has sent pattern
+    const USART *output;
+    std::string pattern;
+    // stop in SLEEP with interrupts disabled, which nothing can end
+    bool sleep;
+
+    StopCondition();
+};
+
+const char *stop_reason_name(StopReason reason);
+
+class Machine
+{
+protected:
+    // peripherals are placement-constructed back to back in one block
+    char *arena;
+    std::vector<Module *> modules;
+    std::vector<std::string> names;
+
+    // instructions already added to metrics
+    uint64_t published;
+
+    void build(const std::vector<ModuleConfig> &configs);
+
+public:
+    AVR *avr;
+    // process() calls since construction, the idle cycles of sleep
+    // included
+    uint64_t steps;
+    // the instructions of those; interrupt entries and sleep are not any
+    uint64_t instructions;
+
+    // detached builds the board's USARTs on a NullBackend rather than
+    // opening their rx and tx, for callers that attach their own
+    Machine(AVR *_avr, const char *config, bool detached = false);
+    virtual ~Machine();
+
+    void initialize();
+    void process();
+    // hands the instructions and cycles run so far to the thread's
+    // metrics; process() does so every METRICS_BATCH steps
+    void publish();
+    StopReason run(const StopCondition &stop);
+
+    Module *find(const char *name);
+    // attaches backend to the USART name and a NullBackend to every other
+    // one, so nothing reaches the process's descriptors; NULL, with
+    // nothing attached, if there is no such USART
+    USART *isolate(const char *name, Backend *backend);
+    const std::vector<Module *> &peripherals() const;
+    const std::vector<std::string> &module_names() const;
+};
+
+#endif
@@ -3,33 +3,445 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <unistd.h>
 #include <stdint.h>
+#include <signal.h>
+#include <chrono>
 #include <functional>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "avr.hh"
+#include "condition.hh"
+#include "forkserver.hh"
+#include "gdb.hh"
+#include "instrumented.hh"
+#include "journal.hh"
+#include "machine.hh"
+#include "metrics.hh"
+#include "profile.hh"
+#include "runner.hh"
+#include "symbols.hh"
+#include "timeline.hh"
 #include "usart.hh"
 
 void usage(const char *fn)
 {
-    fprintf(stderr, "usage: %s [-t type] file\n", fn);
+    fprintf(stderr, "usage: %s [-t type] [-b board] [-R journal] [-T trace [-W]] [-p report] [-g stacks] [-G edges] [-y symbols] [-s stack] [-M metrics] [-S seconds] [-d gdb] file\n", fn);
+    fprintf(stderr, "       %s -B [-c cycles] [-I instructions] [-e 'pc [if condition]'] [-m usart:pattern] [-x watch] [-s stack] [-M metrics] [-o report] [-t type] [-b board] file\n", fn);
+    fprintf(stderr, "       %s -r journal [-t type] [-b board] [-c cycles] [-w addr] file\n", fn);
+    fprintf(stderr, "       %s -j manifest [-n threads] [-M metrics] [-S seconds] [-o report]\n", fn);
+    fprintf(stderr, "       %s -F [-t type] [-b board] [-u usart] [-P pc] [-c cycles] [-i input] file\n", fn);
     fprintf(stderr, "       %s -h\n", fn);
 }
 
+// C escapes \n, \r, \t, \\ and \xHH
+static std::string unescape(const char *s)
+{
+    std::string out;
+    char *end;
+
+    while(*s)
+    {
+        if(*s != '\\' || s[1] == 0)
+        {
+            out += *s++;
+            continue;
+        }
+        s++;
+        switch(*s)
+        {
+        case 'n':
+            out += '\n';
+            break;
+        case 'r':
+            out += '\r';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'x':
+            out += (char)strtoul(s + 1, &end, 16);
+            s = end - 1;
+            break;
+        default:
+            out += *s;
+            break;
+        }
+        s++;
+    }
+    return out;
+}
+
+static volatile sig_atomic_t running = 1;
+
+static void interrupted(int sig)
+{
+    running = 0;
+}
+
+// "-" is stderr
+static FILE *open_report(const char *fn)
+{
+    FILE *f;
+
+    f = strcmp(fn, "-") == 0 ? stderr : fopen(fn, "w");
+    if(f == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    return f;
+}
+
+static void close_report(FILE *f)
+{
+    if(f != stderr)
+    {
+        fclose(f);
+    }
+}
+
+// [r|w|a]:addr[:size][=value]
+static void add_watch(AVR *avr, const char *spec)
+{
+    unsigned long addr, size = 1;
+    long value = -1;
+    uint8_t kind;
+    char *end;
+
+    kind = spec[0] == 'r' ? WATCH_READ : spec[0] == 'w' ? WATCH_WRITE : spec[0] == 'a' ? WATCH_READ | WATCH_WRITE : 0;
+    if(kind == 0 || spec[1] != ':')
+    {
+        fprintf(stderr, "bad watchpoint -- '%s'\n", spec);
+        exit(1);
+    }
+    addr = strtoul(spec + 2, &end, 0);
+    if(*end == ':')
+    {
+        size = strtoul(end + 1, &end, 0);
+    }
+    if(*end == '=')
+    {
+        value = strtol(end + 1, &end, 0) & 0xff;
+    }
+    if(*end != 0 || SRAM_SIZE_BYTES <= addr || size == 0)
+    {
+        fprintf(stderr, "bad watchpoint -- '%s'\n", spec);
+        exit(1);
+    }
+    avr->add_watch(addr, size, kind, value);
+}
+
+// pc [if condition], pc a byte address
+static void stop_at(StopCondition &stop, const char *spec)
+{
+    std::string error;
+    unsigned long pc;
+    char *end;
+
+    pc = strtoul(spec, &end, 0);
+    while(*end == ' ')
+    {
+        end++;
+    }
+    if(end == spec || FLASH_SIZE_BYTES <= pc || (*end != 0 && strncmp(end, "if ", 3) != 0))
+    {
+        fprintf(stderr, "bad stop pc -- '%s'\n", spec);
+        exit(1);
+    }
+    stop.pc = pc >> 1;
+    if(*end != 0)
+    {
+        stop.condition = Condition::compile(end + 3, error);
+        if(stop.condition == NULL)
+        {
+            fprintf(stderr, "bad condition -- '%s': %s\n", end + 3, error.c_str());
+            exit(1);
+        }
+    }
+}
+
+// the lowest address the stack may grow down to, or "heap" for the end of
+// the avr-libc heap as found in the symbols
+static void limit_stack(AVR *avr, const char *spec, const char *symbols)
+{
+    const Symbol *start, *brkval;
+    unsigned long limit;
+    char *end;
+
+    if(strcmp(spec, "heap") != 0)
+    {
+        limit = strtoul(spec, &end, 0);
+        if(*end != 0 || SRAM_SIZE_BYTES <= limit)
+        {
+            fprintf(stderr, "bad stack limit -- '%s'\n", spec);
+            exit(1);
+        }
+        avr->stack_limit = limit;
+        return;
+    }
+    if(symbols == NULL)
+    {
+        fprintf(stderr, "-s heap needs symbols\n");
+        exit(1);
+    }
+    Symbols syms(symbols);
+    // __heap_start until malloc() first moves __brkval off zero
+    start = syms.variable("__heap_start");
+    brkval = syms.variable("__brkval");
+    if(start == NULL && brkval == NULL)
+    {
+        fprintf(stderr, "%s: no __heap_start or __brkval\n", symbols);
+        exit(1);
+    }
+    if(start != NULL)
+    {
+        avr->stack_limit = start->addr;
+    }
+    if(brkval != NULL)
+    {
+        avr->stack_brkval = brkval->addr;
+    }
+}
+
+static void write_metrics(Machine *machine, const char *fn)
+{
+    FILE *f;
+
+    if(fn == NULL)
+    {
+        return;
+    }
+    if(machine != NULL)
+    {
+        machine->publish();
+    }
+    f = open_report(fn);
+    Metrics::json(f);
+    close_report(f);
+}
+
+// closes the trace and writes the reports asked for; symbols come from the
+// ELF file named, if any
+static void finish(Machine *machine, const char *report, const char *stacks, const char *edges, const char *symbols)
+{
+    Trace *trace = machine->avr->trace;
+    Profile *profile = machine->avr->profile;
+    CallGraph *callgraph = machine->avr->callgraph;
+    Symbols syms = symbols == NULL ? Symbols() : Symbols(symbols);
+    FILE *f;
+
+    if(trace != NULL)
+    {
+        trace->cycles(machine->avr->cycle);
+        machine->avr->trace = NULL;
+        delete trace;
+    }
+    if(profile != NULL)
+    {
+        machine->avr->profile = NULL;
+        f = open_report(report);
+        profile->report(f, syms);
+        close_report(f);
+        delete profile;
+    }
+    if(callgraph != NULL)
+    {
+        machine->avr->callgraph = NULL;
+        if(stacks != NULL)
+        {
+            f = open_report(stacks);
+            callgraph->collapsed(f, syms, machine->avr->cycle);
+            close_report(f);
+        }
+        if(edges != NULL)
+        {
+            f = open_report(edges);
+            callgraph->edges(f, syms, machine->avr->cycle);
+            close_report(f);
+        }
+        delete callgraph;
+    }
+}
+
+// 0 when the firmware got where it was asked to, 1 on a fault, 2 when it
+// ran out of its budget
+static int batch_status(StopReason reason)
+{
+    switch(reason)
+    {
+    case STOP_FAULT:
+        return 1;
+    case STOP_CYCLES:
+    case STOP_INSTRUCTIONS:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+static void batch_report(FILE *f, Machine *machine, StopReason reason, uint64_t instructions, double seconds)
+{
+    const std::vector<Module *> &modules = machine->peripherals();
+    const std::vector<std::string> &names = machine->module_names();
+    const char *sep = "";
+    USART *usart;
+
+    fprintf(f, "{\"stop\": \"%s\", \"status\": %d, \"fault\": %d, \"pc\": %u, \"cycles\": %llu, \"instructions\": %llu, \"seconds\": %.6f, \"mips\": %.3f, \"usarts\": [",
+        stop_reason_name(reason), batch_status(reason), machine->avr->fault, (uint32_t)machine->avr->pc << 1,
+        (unsigned long long)machine->avr->cycle, (unsigned long long)instructions, seconds, seconds > 0 ? instructions / seconds / 1e6 : 0.0);
+    for(size_t i = 0; i < modules.size(); i++)
+    {
+        usart = dynamic_cast<USART *>(modules[i]);
+        if(usart != NULL)
+        {
+            fprintf(f, "%s{\"name\": \"%s\", \"rx\": %llu, \"tx\": %llu}", sep, names[i].c_str(),
+                (unsigned long long)usart->received(), (unsigned long long)usart->sent());
+            sep = ", ";
+        }
+    }
+    fprintf(f, "], \"stack_low\": %u", machine->avr->stack_low);
+    if(reason == STOP_WATCH)
+    {
+        fprintf(f, ", \"watch\": {\"addr\": %u, \"data\": %u, \"access\": \"%s\"}", machine->avr->watch_hit.addr,
+            machine->avr->watch_hit.data, machine->avr->watch_hit.kind == WATCH_READ ? "read" : "write");
+    }
+    fprintf(f, "}\n");
+}
+
 int main(int argc, char *argv[])
 {
+    Machine *machine;
+    Runner *runner;
     AVR *avr;
-    USART *usart0, *usart1;
-    const char *type = NULL, *file = NULL;
+    ForkServer *server;
+    Journal *journal = NULL;
+    Timeline *timeline = NULL;
+    StopCondition stop;
+    StopReason reason;
+    std::chrono::steady_clock::time_point start;
+    std::string match;
+    size_t colon;
+    uint64_t cycles = UINT64_MAX;
+    const char *type = NULL, *file = NULL, *board = NULL;
+    const char *manifest = NULL, *report = NULL;
+    const char *usart = "usart0", *input = NULL;
+    const char *record = NULL, *replay = NULL;
+    const char *trace = NULL, *profile = NULL, *symbols = NULL;
+    const char *stacks = NULL, *edges = NULL;
+    const char *stack = NULL;
+    const char *metrics = NULL;
+    const char *debug = NULL;
+    unsigned interval = 0;
+    std::vector<const char *> watches;
+    bool trace_writes = false;
+    unsigned threads = std::thread::hardware_concurrency();
+    bool forkserver = false, batch = false;
+    uint64_t instructions = UINT64_MAX;
+    const char *end_pc = NULL;
+    long boot_pc = -1;
+    long watch = -1;
+    char *end;
+    uint8_t before;
+    FILE *f;
     char ch;
 
-    while((ch = getopt(argc, argv, "t:h")) != -1)
+    while((ch = getopt(argc, argv, "t:b:j:n:o:FP:c:u:i:R:r:w:BI:e:m:T:Wp:y:g:G:x:s:M:S:d:h")) != -1)
     {
         switch(ch)
         {
         case 't':
             type = optarg;
             break;
+        case 'b':
+            board = optarg;
+            break;
+        case 'j':
+            manifest = optarg;
+            break;
+        case 'n':
+            threads = atoi(optarg);
+            break;
+        case 'o':
+            report = optarg;
+            break;
+        case 'F':
+            forkserver = true;
+            break;
+        case 'P':
+            boot_pc = strtol(optarg, NULL, 0);
+            break;
+        case 'c':
+            cycles = strtoull(optarg, NULL, 0);
+            break;
+        case 'u':
+            usart = optarg;
+            break;
+        case 'i':
+            input = optarg;
+            break;
+        case 'R':
+            record = optarg;
+            break;
+        case 'r':
+            replay = optarg;
+            break;
+        case 'w':
+            watch = strtol(optarg, &end, 0);
+            if(*optarg == 0 || *end != 0 || watch < 0 || SRAM_SIZE_BYTES <= watch)
+            {
+                fprintf(stderr, "bad watch address -- '%s'\n", optarg);
+                exit(1);
+            }
+            break;
+        case 'B':
+            batch = true;
+            break;
+        case 'I':
+            instructions = strtoull(optarg, NULL, 0);
+            break;
+        case 'e':
+            end_pc = optarg;
+            break;
+        case 'm':
+            match = optarg;
+            break;
+        case 'T':
+            trace = optarg;
+            break;
+        case 'W':
+            trace_writes = true;
+            break;
+        case 'p':
+            profile = optarg;
+            break;
+        case 'y':
+            symbols = optarg;
+            break;
+        case 'g':
+            stacks = optarg;
+            break;
+        case 'G':
+            edges = optarg;
+            break;
+        case 'x':
+            watches.push_back(optarg);
+            break;
+        case 's':
+            stack = optarg;
+            break;
+        case 'M':
+            metrics = optarg;
+            break;
+        case 'S':
+            interval = atoi(optarg);
+            break;
+        case 'd':
+            debug = optarg;
+            break;
         case 'h':
         case '?':
             break;
@@ -37,26 +449,198 @@ int main(int argc, char *argv[])
     }
     file = argv[optind];
 
+    // the fork server's children must not inherit a half-held lock
+    if(!forkserver && (metrics != NULL || interval != 0))
+    {
+        Metrics::monitor(interval);
+    }
+
+    if(manifest != NULL)
+    {
+        runner = new Runner(manifest, metrics != NULL || interval != 0);
+        runner->run(threads);
+
+        f = report == NULL ? stdout : fopen(report, "w");
+        if(f == NULL)
+        {
+            perror(report);
+            exit(1);
+        }
+        runner->report(f);
+        fclose(f);
+        delete runner;
+        write_metrics(NULL, metrics);
+        return 0;
+    }
+
     if(file == NULL || type == NULL)
     {
         usage(argv[0]);
         exit(1);
     }
 
-    avr = new AVR(file, type);
-    usart0 = new USART(avr, 3, 4, 0x2c, 0x2b, 0x2a, 0x95, 0x12, 0x13, 0x14);
-    usart1 = new USART(avr, 5, 6, 0x9c, 0x9b, 0x9a, 0x9d, 0x1e, 0x1f, 0x20);
+    // the plain core unless something needs what only Instrumented does
+    if(trace != NULL || profile != NULL || stacks != NULL || edges != NULL || !watches.empty() || 0 <= watch || debug != NULL || metrics != NULL || interval != 0)
+    {
+        avr = new Instrumented(file, type);
+    }
+    else
+    {
+        avr = new AVR(file, type);
+    }
+    machine = new Machine(avr, board, forkserver);
+
+    if(forkserver)
+    {
+        server = new ForkServer(machine, usart);
+        server->boot(boot_pc, cycles);
+        server->stop.cycles = cycles;
+        server->serve(input);
+    }
+
+    if(record != NULL || replay != NULL)
+    {
+        journal = new Journal(machine->avr, replay == NULL ? record : replay, replay != NULL);
+        journal->attach(machine);
+    }
+
+    machine->initialize();
+
+    if(trace != NULL)
+    {
+        machine->avr->trace = new Trace(trace, trace_writes);
+    }
+    if(profile != NULL)
+    {
+        machine->avr->profile = new Profile();
+    }
+    if(stacks != NULL || edges != NULL)
+    {
+        machine->avr->callgraph = new CallGraph();
+    }
+    if(symbols == NULL && strcasecmp(type, "elf") == 0)
+    {
+        symbols = file;
+    }
+    if(stack != NULL)
+    {
+        limit_stack(machine->avr, stack, symbols);
+    }
+
+    if(debug != NULL)
+    {
+        // stepping back needs a run that repeats, so it comes with -R or -r
+        if(journal != NULL)
+        {
+            timeline = new Timeline(machine, journal, TIMELINE_INTERVAL);
+        }
+        GdbServer gdb(machine, timeline, debug);
+        gdb.serve();
+    }
+
+    if(replay != NULL)
+    {
+        if(0 <= watch && timeline == NULL)
+        {
+            timeline = new Timeline(machine, journal, TIMELINE_INTERVAL);
+        }
+        // past the last event only if asked to with -c
+        while(machine->avr->fault == AVR_FAULT_NONE && (cycles == UINT64_MAX ? !journal->finished() : machine->avr->cycle < cycles))
+        {
+            if(timeline != NULL)
+            {
+                timeline->step();
+            }
+            else
+            {
+                machine->process();
+            }
+        }
+        fprintf(stderr, "replayed %zu events, stopped at cycle %llu\n", journal->size(), (unsigned long long)machine->avr->cycle);
+        // the search below runs parts of the session again
+        finish(machine, profile, stacks, edges, symbols);
+        write_metrics(machine, metrics);
 
-    avr->initialize();
-    usart0->initialize();
-    usart1->initialize();
+        // the timeline can also be there for -g alone
+        if(timeline != NULL && 0 <= watch)
+        {
+            if(timeline->last_write(watch))
+            {
+                fprintf(stderr, "last write to %04lx: pc %x, cycle %llu, ", watch, (uint32_t)machine->avr->pc << 1, (unsigned long long)machine->avr->cycle);
+                before = machine->avr->sram.bytes[watch];
+                timeline->step();
+                fprintf(stderr, "%02x -> %02x\n", before, machine->avr->sram.bytes[watch]);
+            }
+            else
+            {
+                fprintf(stderr, "no write to %04lx\n", watch);
+            }
+        }
+        return machine->avr->fault == AVR_FAULT_NONE ? 0 : 1;
+    }
 
-    while(true)
+    if(batch)
+    {
+        for(const char *spec : watches)
+        {
+            add_watch(machine->avr, spec);
+        }
+        stop.cycles = cycles;
+        stop.instructions = instructions;
+        if(end_pc != NULL)
+        {
+            stop_at(stop, end_pc);
+        }
+        if(!match.empty())
+        {
+            colon = match.find(':');
+            stop.output = colon == std::string::npos ? NULL : dynamic_cast<USART *>(machine->find(match.substr(0, colon).c_str()));
+            if(stop.output == NULL)
+            {
+                fprintf(stderr, "no such usart -- '%s'\n", match.substr(0, colon).c_str());
+                exit(1);
+            }
+            stop.pattern = unescape(match.c_str() + colon + 1);
+            if(stop.pattern.empty() || USART_TAIL_SIZE < stop.pattern.size())
+            {
+                fprintf(stderr, "pattern must be 1 to %u bytes long\n", USART_TAIL_SIZE);
+                exit(1);
+            }
+        }
+
+        start = std::chrono::steady_clock::now();
+        reason = machine->run(stop);
+
+        f = report == NULL ? stderr : fopen(report, "w");
+        if(f == NULL)
+        {
+            perror(report);
+            exit(1);
+        }
+        batch_report(f, machine, reason, machine->instructions,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if(report != NULL)
+        {
+            fclose(f);
+        }
+        finish(machine, profile, stacks, edges, symbols);
+        write_metrics(machine, metrics);
+        return batch_status(reason);
+    }
+
+    if(trace != NULL || profile != NULL || stacks != NULL || edges != NULL || metrics != NULL)
+    {
+        // end cleanly so the trace and reports make it to their files
+        signal(SIGINT, interrupted);
+        signal(SIGTERM, interrupted);
+    }
+    // until a fault, which has been printed
+    while(running && machine->avr->fault == AVR_FAULT_NONE)
     {
-        avr->process();
-        usart0->process();
-        usart1->process();
+        machine->process();
     }
 
-    return 0;
+    finish(machine, profile, stacks, edges, symbols);
+    write_metrics(machine, metrics);
+    return machine->avr->fault == AVR_FAULT_NONE ? 0 : 1;
 }
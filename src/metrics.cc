@@ -0,0 +1,163 @@
+// metrics.cc
+
+#include <chrono>
+#include <csignal>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "metrics.hh"
+
+#define METRICS_TICK_MS (100u)
+
+struct Totals
+{
+    uint64_t instructions, cycles, irqs, rx_bytes, tx_bytes, syscalls;
+};
+
+static std::mutex lock;
+static std::vector<Metrics *> threads;
+static const std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+static volatile sig_atomic_t requested = 0;
+
+static uint64_t get(const Counter &counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+static void add(Totals &totals, const Metrics *metrics)
+{
+    totals.instructions += get(metrics->instructions);
+    totals.cycles += get(metrics->cycles);
+    totals.irqs += get(metrics->irqs);
+    totals.rx_bytes += get(metrics->rx_bytes);
+    totals.tx_bytes += get(metrics->tx_bytes);
+    totals.syscalls += get(metrics->syscalls);
+}
+
+static void print_totals(FILE *f, const Totals &totals, double seconds)
+{
+    fprintf(f, "\"instructions\": %llu, \"cycles\": %llu, \"mips\": %.3f, \"mhz\": %.3f, \"irqs\": %llu, \"rx_bytes\": %llu, \"tx_bytes\": %llu, \"syscalls\": %llu",
+        (unsigned long long)totals.instructions, (unsigned long long)totals.cycles,
+        seconds > 0 ? totals.instructions / seconds / 1e6 : 0.0, seconds > 0 ? totals.cycles / seconds / 1e6 : 0.0,
+        (unsigned long long)totals.irqs, (unsigned long long)totals.rx_bytes, (unsigned long long)totals.tx_bytes,
+        (unsigned long long)totals.syscalls);
+}
+
+static double elapsed()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+static void usr1(int sig)
+{
+    requested = 1;
+}
+
+Metrics::Metrics()
+    : instructions(0), cycles(0), irqs(0), rx_bytes(0), tx_bytes(0), syscalls(0)
+{
+    for(unsigned i = 0; i < METRICS_IO_SIZE; i++)
+    {
+        io_reads[i].store(0, std::memory_order_relaxed);
+        io_writes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+Metrics *Metrics::local()
+{
+    static thread_local Metrics *metrics = NULL;
+
+    if(metrics == NULL)
+    {
+        metrics = new Metrics();
+        std::lock_guard<std::mutex> guard(lock);
+        threads.push_back(metrics);
+    }
+    return metrics;
+}
+
+void Metrics::line(FILE *f)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    Totals totals = {};
+    double seconds = elapsed();
+
+    for(const Metrics *metrics : threads)
+    {
+        add(totals, metrics);
+    }
+    fprintf(f, "stats: %.1f s, %llu instructions, %.3f MIPS, %.3f MHz, %llu irqs, %llu/%llu usart bytes in/out, %llu syscalls\n",
+        seconds, (unsigned long long)totals.instructions, seconds > 0 ? totals.instructions / seconds / 1e6 : 0.0,
+        seconds > 0 ? totals.cycles / seconds / 1e6 : 0.0, (unsigned long long)totals.irqs,
+        (unsigned long long)totals.rx_bytes, (unsigned long long)totals.tx_bytes, (unsigned long long)totals.syscalls);
+}
+
+void Metrics::json(FILE *f)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    Totals totals = {};
+    uint64_t reads, writes;
+    double seconds = elapsed();
+    const char *sep = "";
+
+    for(const Metrics *metrics : threads)
+    {
+        add(totals, metrics);
+    }
+    fprintf(f, "{\"seconds\": %.6f, ", seconds);
+    print_totals(f, totals, seconds);
+
+    fprintf(f, ", \"io\": [");
+    for(unsigned i = 0; i < METRICS_IO_SIZE; i++)
+    {
+        reads = writes = 0;
+        for(const Metrics *metrics : threads)
+        {
+            reads += get(metrics->io_reads[i]);
+            writes += get(metrics->io_writes[i]);
+        }
+        if(reads != 0 || writes != 0)
+        {
+            fprintf(f, "%s{\"addr\": %u, \"reads\": %llu, \"writes\": %llu}", sep, i, (unsigned long long)reads, (unsigned long long)writes);
+            sep = ", ";
+        }
+    }
+
+    fprintf(f, "], \"threads\": [");
+    sep = "";
+    for(const Metrics *metrics : threads)
+    {
+        Totals own = {};
+        add(own, metrics);
+        fprintf(f, "%s{", sep);
+        print_totals(f, own, seconds);
+        fprintf(f, "}");
+        sep = ", ";
+    }
+    fprintf(f, "]}\n");
+}
+
+void Metrics::monitor(unsigned interval)
+{
+    signal(SIGUSR1, usr1);
+    std::thread([interval]()
+        {
+            std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now() + std::chrono::seconds(interval);
+
+            while(true)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(METRICS_TICK_MS));
+                if(requested)
+                {
+                    requested = 0;
+                    line(stderr);
+                }
+                if(interval != 0 && next <= std::chrono::steady_clock::now())
+                {
+                    next += std::chrono::seconds(interval);
+                    line(stderr);
+                }
+            }
+        }).detach();
+}
@@ -0,0 +1,53 @@
+// metrics.hh
+
+#ifndef AVRE_METRICS_HH
+#define AVRE_METRICS_HH
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// instructions and cycles are handed over in batches of this many steps
+#define METRICS_BATCH   (0x10000u)
+#define METRICS_IO_SIZE (0x100u)
+
+typedef std::atomic<uint64_t> Counter;
+
+// the counters of one emulator thread; only that thread writes them, with
+// plain relaxed loads and stores and no locked instructions, and readers
+// on other threads see values that may lag a little
+struct Metrics
+{
+    Counter instructions;
+    Counter cycles;
+    Counter irqs;
+    Counter rx_bytes;
+    Counter tx_bytes;
+    // select(), read() and write() calls made for the guest's USARTs
+    Counter syscalls;
+    // calls of the access handlers of each I/O register
+    Counter io_reads[METRICS_IO_SIZE];
+    Counter io_writes[METRICS_IO_SIZE];
+
+    Metrics();
+
+    static void count(Counter &counter, uint64_t n = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    // the calling thread's counters, set up on first use; they outlive
+    // the thread, so totals include threads that have finished
+    static Metrics *local();
+
+    // one line of totals
+    static void line(FILE *f);
+    // totals, busy I/O registers and per-thread figures as JSON
+    static void json(FILE *f);
+
+    // a thread that prints a line to stderr on SIGUSR1 and, if interval
+    // is not 0, every interval seconds
+    static void monitor(unsigned interval);
+};
+
+#endif
@@ -9,3 +9,16 @@ Module::Module()
 Module::~Module()
 {
 }
+
+size_t Module::state_size()
+{
+    return 0;
+}
+
+void Module::save(uint8_t *state)
+{
+}
+
+void Module::load(const uint8_t *state)
+{
+}
@@ -3,6 +3,9 @@
 #ifndef AVRE_MODULE_HH
 #define AVRE_MODULE_HH
 
+#include <cstddef>
+#include <cstdint>
+
 class Module
 {
 public:
@@ -11,6 +14,11 @@ public:
 
     virtual void initialize() = 0;
     virtual void process() = 0;
+
+    // internal state as a fixed-size blob, for snapshots
+    virtual size_t state_size();
+    virtual void save(uint8_t *state);
+    virtual void load(const uint8_t *state);
 };
 
 #endif
@@ -0,0 +1,135 @@
+// opcode.cc
+
+#include <cstddef>
+#include <cstring>
+
+#include "opcode.hh"
+
+const Opcode opcodes[OPCODE_COUNT] = {
+    {"ADC", 0xfc00, 0x1c00, 1},
+    {"ADD", 0xfc00, 0x0c00, 1},
+    {"ADIW", 0xff00, 0x9600, 1},
+    {"AND", 0xfc00, 0x2000, 1},
+    {"ANDI", 0xf000, 0x7000, 1},
+    {"ASR", 0xfe0f, 0x9405, 1},
+    {"BCLR", 0xff8f, 0x9488, 1},
+    {"BLD", 0xfe08, 0xf800, 1},
+    {"BRBC", 0xfc00, 0xf400, 1},
+    {"BRBS", 0xfc00, 0xf000, 1},
+    {"BREAK", 0xffff, 0x9598, 1},
+    {"BSET", 0xff8f, 0x9408, 1},
+    {"BST", 0xfe08, 0xfa00, 1},
+    {"CALL", 0xfe0e, 0x940e, 2},
+    {"CBI", 0xff00, 0x9800, 1},
+    {"COM", 0xfe0f, 0x9400, 1},
+    {"CP", 0xfc00, 0x1400, 1},
+    {"CPC", 0xfc00, 0x0400, 1},
+    {"CPI", 0xf000, 0x3000, 1},
+    {"CPSE", 0xfc00, 0x1000, 1},
+    {"DEC", 0xfe0f, 0x940a, 1},
+    {"DES", 0xff0f, 0x940b, 1},
+    {"EICALL", 0xffff, 0x9519, 1},
+    {"EIJMP", 0xffff, 0x9419, 1},
+    {"ELPM_1", 0xffff, 0x95d8, 1},
+    {"ELPM_2", 0xfe0f, 0x9006, 1},
+    {"ELPM_3", 0xfe0f, 0x9007, 1},
+    {"EOR", 0xfc00, 0x2400, 1},
+    {"FMUL", 0xff88, 0x0308, 1},
+    {"FMULS", 0xff88, 0x0380, 1},
+    {"FMULSU", 0xff88, 0x0388, 1},
+    {"ICALL", 0xffff, 0x9509, 1},
+    {"IJMP", 0xffff, 0x9409, 1},
+    {"IN", 0xf800, 0xb000, 1},
+    {"INC", 0xfe0f, 0x9403, 1},
+    {"JMP", 0xfe0e, 0x940c, 2},
+    {"LDI", 0xf000, 0xe000, 1},
+    {"LDS", 0xfe0f, 0x9000, 2},
+    {"LD_X1", 0xfe0f, 0x900c, 1},
+    {"LD_X2", 0xfe0f, 0x900d, 1},
+    {"LD_X3", 0xfe0f, 0x900e, 1},
+    {"LD_Y2", 0xfe0f, 0x9009, 1},
+    {"LD_Y3", 0xfe0f, 0x900a, 1},
+    {"LD_Y4", 0xd208, 0x8008, 1},
+    {"LD_Z2", 0xfe0f, 0x9001, 1},
+    {"LD_Z3", 0xfe0f, 0x9002, 1},
+    {"LD_Z4", 0xd208, 0x8000, 1},
+    {"LPM_1", 0xffff, 0x95c8, 1},
+    {"LPM_2", 0xfe0f, 0x9004, 1},
+    {"LPM_3", 0xfe0f, 0x9005, 1},
+    {"LSR", 0xfe0f, 0x9406, 1},
+    {"MOV", 0xfc00, 0x2c00, 1},
+    {"MOVW", 0xff00, 0x0100, 1},
+    {"MUL", 0xfc00, 0x9c00, 1},
+    {"MULS", 0xff00, 0x0200, 1},
+    {"MULSU", 0xff88, 0x0300, 1},
+    {"NEG", 0xfe0f, 0x9401, 1},
+    {"NOP", 0xffff, 0x0000, 1},
+    {"OR", 0xfc00, 0x2800, 1},
+    {"ORI", 0xf000, 0x6000, 1},
+    {"OUT", 0xf800, 0xb800, 1},
+    {"POP", 0xfe0f, 0x900f, 1},
+    {"PUSH", 0xfe0f, 0x920f, 1},
+    {"RCALL", 0xf000, 0xd000, 1},
+    {"RET", 0xffff, 0x9508, 1},
+    {"RETI", 0xffff, 0x9518, 1},
+    {"RJMP", 0xf000, 0xc000, 1},
+    {"ROR", 0xfe0f, 0x9407, 1},
+    {"SBC", 0xfc00, 0x0800, 1},
+    {"SBCI", 0xf000, 0x4000, 1},
+    {"SBI", 0xff00, 0x9a00, 1},
+    {"SBIC", 0xff00, 0x9900, 1},
+    {"SBIS", 0xff00, 0x9b00, 1},
+    {"SBIW", 0xff00, 0x9700, 1},
+    {"SBRC", 0xfe08, 0xfc00, 1},
+    {"SBRS", 0xfe08, 0xfe00, 1},
+    {"SLEEP", 0xffff, 0x9588, 1},
+    {"SPM2_1", 0xffff, 0x95e8, 1},
+    {"SPM2_2", 0xffff, 0x95f8, 1},
+    {"STS", 0xfe0f, 0x9200, 2},
+    {"ST_X1", 0xfe0f, 0x920c, 1},
+    {"ST_X2", 0xfe0f, 0x920d, 1},
+    {"ST_X3", 0xfe0f, 0x920e, 1},
+    {"ST_Y2", 0xfe0f, 0x9209, 1},
+    {"ST_Y3", 0xfe0f, 0x920a, 1},
+    {"ST_Y4", 0xd208, 0x8208, 1},
+    {"ST_Z2", 0xfe0f, 0x9201, 1},
+    {"ST_Z3", 0xfe0f, 0x9202, 1},
+    {"ST_Z4", 0xd208, 0x8200, 1},
+    {"SUB", 0xfc00, 0x1800, 1},
+    {"SUBI", 0xf000, 0x5000, 1},
+    {"SWAP", 0xfe0f, 0x9402, 1},
+    {"WDR", 0xffff, 0x95a8, 1},
+};
+
+// the opcode index of every instruction word, OPCODE_COUNT for illegal
+// ones, worked out once so finding one is a lookup rather than a scan
+struct OpcodeTable
+{
+    uint8_t index[0x10000];
+
+    OpcodeTable()
+    {
+        memset(index, OPCODE_COUNT, sizeof(index));
+        // every word an opcode matches, walking the subsets of the bits
+        // its mask leaves free
+        for(unsigned i = 0; i < OPCODE_COUNT; i++)
+        {
+            uint16_t free = ~opcodes[i].mask, bits = 0;
+
+            do
+            {
+                index[opcodes[i].match | bits] = i;
+                bits = (bits - free) & free;
+            }
+            while(bits != 0);
+        }
+    }
+};
+
+const Opcode *Opcode::find(uint16_t inst)
+{
+    static OpcodeTable table;
+    uint8_t i = table.index[inst];
+
+    return i == OPCODE_COUNT ? NULL : &opcodes[i];
+}
@@ -0,0 +1,26 @@
+// opcode.hh
+
+#ifndef AVRE_OPCODE_HH
+#define AVRE_OPCODE_HH
+
+#include <cstdint>
+
+#define OPCODE_COUNT (93u)
+
+// one instruction handler's encodings: those with (inst & mask) == match.
+// The patterns do not overlap, and what none of them matches is illegal
+struct Opcode
+{
+    // the handler's name without do_, so LD_X2 for LD Rd, X+
+    const char *name;
+    uint16_t mask;
+    uint16_t match;
+    // 2 for those followed by an address word
+    uint8_t words;
+
+    static const Opcode *find(uint16_t inst);
+};
+
+extern const Opcode opcodes[OPCODE_COUNT];
+
+#endif
@@ -0,0 +1,112 @@
+// profile.cc
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "profile.hh"
+
+struct ProfileLine
+{
+    const char *name;
+    uint32_t addr;
+    uint64_t hits;
+    uint64_t cycles;
+};
+
+static void print_line(FILE *f, const ProfileLine &line, uint64_t total, bool with_addr)
+{
+    fprintf(f, "%14llu %5.1f%% %14llu  ", (unsigned long long)line.cycles, total == 0 ? 0.0 : line.cycles * 100.0 / total, (unsigned long long)line.hits);
+    if(with_addr)
+    {
+        fprintf(f, "%05x  ", line.addr);
+    }
+    fprintf(f, "%s\n", line.name);
+}
+
+Profile::Profile()
+{
+    memset(hits, 0, sizeof(hits));
+    memset(cycles, 0, sizeof(cycles));
+}
+
+void Profile::report(FILE *f, const Symbols &symbols) const
+{
+    std::map<const Symbol *, ProfileLine> functions;
+    std::vector<ProfileLine> lines;
+    std::vector<std::string> names;
+    const Symbol *symbol;
+    ProfileLine line;
+    uint64_t total = 0;
+    char buf[32];
+
+    auto hotter = [](const ProfileLine &a, const ProfileLine &b)
+    {
+        return a.cycles > b.cycles;
+    };
+
+    for(uint32_t pc = 0; pc < PROFILE_WORDS; pc++)
+    {
+        if(hits[pc] == 0)
+        {
+            continue;
+        }
+        total += cycles[pc];
+        line.name = NULL;
+        line.addr = pc << 1;
+        line.hits = hits[pc];
+        line.cycles = cycles[pc];
+        lines.push_back(line);
+
+        symbol = symbols.find(pc << 1);
+        ProfileLine &func = functions[symbol];
+        func.name = symbol == NULL ? "?" : symbol->name.c_str();
+        func.addr = symbol == NULL ? 0 : symbol->addr;
+        func.hits += hits[pc];
+        func.cycles += cycles[pc];
+    }
+
+    std::sort(lines.begin(), lines.end(), hotter);
+    if(PROFILE_TOP < lines.size())
+    {
+        lines.resize(PROFILE_TOP);
+    }
+    names.reserve(lines.size());
+    for(ProfileLine &hot : lines)
+    {
+        symbol = symbols.find(hot.addr);
+        if(symbol == NULL)
+        {
+            names.push_back("?");
+        }
+        else
+        {
+            snprintf(buf, sizeof(buf), "+0x%x", hot.addr - symbol->addr);
+            names.push_back(symbol->name + buf);
+        }
+        hot.name = names.back().c_str();
+    }
+
+    fprintf(f, "%14s %6s %14s  %-5s  %s\n", "cycles", "share", "hits", "addr", "location");
+    for(const ProfileLine &hot : lines)
+    {
+        print_line(f, hot, total, true);
+    }
+
+    if(symbols.empty())
+    {
+        return;
+    }
+    lines.clear();
+    for(const std::pair<const Symbol *const, ProfileLine> &func : functions)
+    {
+        lines.push_back(func.second);
+    }
+    std::sort(lines.begin(), lines.end(), hotter);
+    fprintf(f, "\n%14s %6s %14s  %s\n", "cycles", "share", "instructions", "function");
+    for(const ProfileLine &func : lines)
+    {
+        print_line(f, func, total, false);
+    }
+}
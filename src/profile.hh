@@ -0,0 +1,34 @@
+// profile.hh
+
+#ifndef AVRE_PROFILE_HH
+#define AVRE_PROFILE_HH
+
+#include <cstdint>
+#include <cstdio>
+
+#include "symbols.hh"
+
+#define PROFILE_WORDS (0x10000u)
+// hottest addresses listed in a report
+#define PROFILE_TOP   (40u)
+
+// executions and cycles per flash word, indexed by word pc
+class Profile
+{
+public:
+    uint64_t hits[PROFILE_WORDS];
+    uint64_t cycles[PROFILE_WORDS];
+
+    Profile();
+
+    void count(uint16_t pc, int taken)
+    {
+        hits[pc]++;
+        cycles[pc] += taken;
+    }
+
+    // the hottest addresses and, with symbols, the hottest functions
+    void report(FILE *f, const Symbols &symbols) const;
+};
+
+#endif
@@ -0,0 +1,149 @@
+// registry.cc
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#include "registry.hh"
+
+void ModuleConfig::set(const std::string &key, const std::string &value)
+{
+    values[key] = value;
+}
+
+bool ModuleConfig::has(const char *key) const
+{
+    return values.find(key) != values.end();
+}
+
+const char *ModuleConfig::get_string(const char *key) const
+{
+    std::map<std::string, std::string>::const_iterator it;
+
+    it = values.find(key);
+    if(it == values.end())
+    {
+        fprintf(stderr, "%s: %s: missing '%s'\n", where.c_str(), name.c_str(), key);
+        exit(1);
+    }
+    return it->second.c_str();
+}
+
+const char *ModuleConfig::get_string(const char *key, const char *def) const
+{
+    return has(key) ? get_string(key) : def;
+}
+
+uint32_t ModuleConfig::get_uint(const char *key) const
+{
+    uint64_t v = get_uint64(key);
+    if(UINT32_MAX < v)
+    {
+        fprintf(stderr, "%s: %s: '%s' out of range\n", where.c_str(), name.c_str(), key);
+        exit(1);
+    }
+    return v;
+}
+
+uint32_t ModuleConfig::get_uint(const char *key, uint32_t def) const
+{
+    return has(key) ? get_uint(key) : def;
+}
+
+uint64_t ModuleConfig::get_uint64(const char *key) const
+{
+    const char *s;
+    char *end;
+    unsigned long long v;
+
+    s = get_string(key);
+    v = strtoull(s, &end, 0);
+    if(*s == '\0' || *end != '\0')
+    {
+        fprintf(stderr, "%s: %s: '%s' is not a number -- '%s'\n", where.c_str(), name.c_str(), key, s);
+        exit(1);
+    }
+    return v;
+}
+
+uint64_t ModuleConfig::get_uint64(const char *key, uint64_t def) const
+{
+    return has(key) ? get_uint64(key) : def;
+}
+
+void ModuleConfig::parse(const std::string &text, const char *where, std::vector<ModuleConfig> &configs)
+{
+    std::istringstream in(text);
+    std::string line, word;
+    size_t eq;
+    int lineno = 0;
+
+    while(std::getline(in, line))
+    {
+        lineno++;
+        if(line.find('#') != std::string::npos)
+        {
+            line.erase(line.find('#'));
+        }
+
+        std::istringstream words(line);
+        ModuleConfig config;
+        if(!(words >> config.type))
+        {
+            continue;
+        }
+        config.where = std::string(where) + ":" + std::to_string(lineno);
+        while(words >> word)
+        {
+            eq = word.find('=');
+            if(eq == std::string::npos || eq == 0)
+            {
+                fprintf(stderr, "%s: expected key=value -- '%s'\n", config.where.c_str(), word.c_str());
+                exit(1);
+            }
+            config.set(word.substr(0, eq), word.substr(eq + 1));
+        }
+        config.name = config.has("name") ? config.get_string("name") : config.type + std::to_string(configs.size());
+        configs.push_back(config);
+    }
+}
+
+std::string ModuleConfig::read_file(const char *fn)
+{
+    std::string text;
+    FILE *f;
+    char buf[4096];
+    size_t n;
+
+    f = fopen(fn, "r");
+    if(f == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    while((n = fread(buf, 1, sizeof(buf), f)) != 0)
+    {
+        text.append(buf, n);
+    }
+    fclose(f);
+    return text;
+}
+
+std::map<std::string, ModuleFactory> &ModuleRegistry::factories()
+{
+    static std::map<std::string, ModuleFactory> table;
+    return table;
+}
+
+void ModuleRegistry::add(const char *name, const ModuleFactory &factory)
+{
+    factories()[name] = factory;
+}
+
+const ModuleFactory *ModuleRegistry::find(const std::string &name)
+{
+    std::map<std::string, ModuleFactory>::const_iterator it;
+
+    it = factories().find(name);
+    return it == factories().end() ? NULL : &it->second;
+}
@@ -0,0 +1,80 @@
+// registry.hh
+
+#ifndef AVRE_REGISTRY_HH
+#define AVRE_REGISTRY_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "module.hh"
+
+class AVR;
+
+class ModuleConfig
+{
+protected:
+    std::map<std::string, std::string> values;
+
+public:
+    std::string type;
+    std::string name;
+    std::string where;
+
+    void set(const std::string &key, const std::string &value);
+    bool has(const char *key) const;
+
+    const char *get_string(const char *key) const;
+    const char *get_string(const char *key, const char *def) const;
+    uint32_t get_uint(const char *key) const;
+    uint32_t get_uint(const char *key, uint32_t def) const;
+    uint64_t get_uint64(const char *key) const;
+    uint64_t get_uint64(const char *key, uint64_t def) const;
+
+    // one entry per line: a type word followed by key=value pairs
+    static void parse(const std::string &text, const char *where, std::vector<ModuleConfig> &configs);
+    static std::string read_file(const char *fn);
+};
+
+struct ModuleFactory
+{
+    size_t size;
+    size_t align;
+    Module *(*create)(void *mem, AVR *avr, const ModuleConfig &config);
+};
+
+class ModuleRegistry
+{
+protected:
+    static std::map<std::string, ModuleFactory> &factories();
+
+public:
+    static void add(const char *name, const ModuleFactory &factory);
+    static const ModuleFactory *find(const std::string &name);
+};
+
+template<class T>
+class ModuleRegistrar
+{
+protected:
+    static Module *create(void *mem, AVR *avr, const ModuleConfig &config)
+    {
+        return new(mem) T(avr, config);
+    }
+
+public:
+    ModuleRegistrar(const char *name)
+    {
+        ModuleFactory factory = {sizeof(T), alignof(T), create};
+        ModuleRegistry::add(name, factory);
+    }
+};
+
+// peripherals are constructed as T(AVR *, const ModuleConfig &)
+#define REGISTER_MODULE(name, T) \
+    static ModuleRegistrar<T> registrar_##T(name)
+
+#endif
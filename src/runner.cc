@@ -0,0 +1,262 @@
+// runner.cc
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "instrumented.hh"
+#include "runner.hh"
+#include "usart.hh"
+
+static void json_string(FILE *f, const std::string &s)
+{
+    fputc('"', f);
+    for(size_t i = 0; i < s.size(); i++)
+    {
+        unsigned char c = s[i];
+        if(c == '"' || c == '\\')
+        {
+            fprintf(f, "\\%c", c);
+        }
+        else if(c < 0x20)
+        {
+            fprintf(f, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+// the file can be opened, or the error why not
+static std::string readable(const std::string &fn)
+{
+    FILE *f = fopen(fn.c_str(), "rb");
+
+    if(f == NULL)
+    {
+        return fn + ": " + strerror(errno);
+    }
+    fclose(f);
+    return "";
+}
+
+// reads the input, loads the firmware and looks the usart up on the
+// board, or sets the job's error. The board is built detached, so nothing
+// is opened; a firmware or board file that cannot be parsed still exits,
+// but here, before any job has run
+void Runner::load(Job &job)
+{
+    std::string key;
+    FILE *f;
+    int c;
+
+    if(!job.input.empty())
+    {
+        f = fopen(job.input.c_str(), "rb");
+        if(f == NULL)
+        {
+            job.error = job.input + ": " + strerror(errno);
+            return;
+        }
+        while((c = fgetc(f)) != EOF)
+        {
+            job.data.push_back(c);
+        }
+        fclose(f);
+    }
+    job.error = readable(job.firmware);
+    if(job.error.empty() && !job.board.empty())
+    {
+        job.error = readable(job.board);
+    }
+    if(!job.error.empty())
+    {
+        return;
+    }
+
+    if(usarts.find(job.board) == usarts.end())
+    {
+        FlashImage blank;
+        Machine machine(new AVR(blank), job.board.empty() ? NULL : job.board.c_str(), true);
+        std::set<std::string> &names = usarts[job.board];
+
+        for(size_t i = 0; i < machine.peripherals().size(); i++)
+        {
+            if(dynamic_cast<USART *>(machine.peripherals()[i]) != NULL)
+            {
+                names.insert(machine.module_names()[i]);
+            }
+        }
+    }
+    if(usarts[job.board].count(job.usart) == 0)
+    {
+        job.error = "no such usart -- '" + job.usart + "'";
+        return;
+    }
+
+    key = job.type + ":" + job.firmware;
+    if(images.find(key) == images.end())
+    {
+        images[key] = new FlashImage(job.firmware.c_str(), job.type.c_str());
+    }
+    job.image = images[key];
+}
+
+Runner::Runner(const char *manifest, bool _instrumented)
+    : instrumented(_instrumented)
+{
+    std::vector<ModuleConfig> configs;
+
+    ModuleConfig::parse(ModuleConfig::read_file(manifest), manifest, configs);
+    for(size_t i = 0; i < configs.size(); i++)
+    {
+        const ModuleConfig &config = configs[i];
+        Job job;
+
+        if(config.type != "job")
+        {
+            fprintf(stderr, "%s: expected a job -- '%s'\n", config.where.c_str(), config.type.c_str());
+            exit(1);
+        }
+        job.name = config.name;
+        job.firmware = config.get_string("fw");
+        job.type = config.get_string("type", "ihex");
+        job.board = config.get_string("board", "");
+        job.input = config.get_string("input", "");
+        job.usart = config.get_string("usart", "usart0");
+        job.stop.cycles = config.get_uint64("cycles");
+        job.reason = STOP_NONE;
+        job.fault = AVR_FAULT_NONE;
+        job.cycle = 0;
+        job.image = NULL;
+        load(job);
+        jobs.push_back(job);
+    }
+}
+
+Runner::~Runner()
+{
+    for(std::map<std::string, FlashImage *>::iterator it = images.begin(); it != images.end(); it++)
+    {
+        delete it->second;
+    }
+}
+
+bool Runner::next(size_t id, size_t &job)
+{
+    {
+        std::lock_guard<std::mutex> guard(queues[id].lock);
+        if(!queues[id].jobs.empty())
+        {
+            job = queues[id].jobs.front();
+            queues[id].jobs.pop_front();
+            return true;
+        }
+    }
+    for(size_t i = 1; i < queues.size(); i++)
+    {
+        Queue &victim = queues[(id + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.jobs.empty())
+        {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void Runner::work(size_t id)
+{
+    size_t job;
+
+    // nothing is queued once the threads start, so empty means done
+    while(next(id, job))
+    {
+        if(jobs[job].error.empty())
+        {
+            execute(jobs[job]);
+        }
+    }
+}
+
+void Runner::execute(Job &job)
+{
+    MemoryBackend *backend;
+    Machine *machine;
+    AVR *avr;
+
+    avr = instrumented ? new Instrumented(*job.image) : new AVR(*job.image);
+    // load() made sure of the board and the usart
+    machine = new Machine(avr, job.board.empty() ? NULL : job.board.c_str(), true);
+    backend = new MemoryBackend();
+    backend->feed(job.data.data(), job.data.size());
+    machine->isolate(job.usart.c_str(), backend);
+
+    machine->initialize();
+    job.reason = machine->run(job.stop);
+    job.fault = machine->avr->fault;
+    job.cycle = machine->avr->cycle;
+    job.output = backend->output;
+
+    delete machine;
+}
+
+void Runner::run(unsigned threads)
+{
+    std::vector<std::thread> workers;
+
+    if(threads == 0)
+    {
+        threads = 1;
+    }
+    queues = std::vector<Queue>(threads);
+    for(size_t i = 0; i < jobs.size(); i++)
+    {
+        queues[i % threads].jobs.push_back(i);
+    }
+
+    for(unsigned i = 0; i < threads; i++)
+    {
+        workers.push_back(std::thread(&Runner::work, this, i));
+    }
+    for(size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+}
+
+void Runner::report(FILE *f)
+{
+    fprintf(f, "{\"jobs\": [\n");
+    for(size_t i = 0; i < jobs.size(); i++)
+    {
+        const Job &job = jobs[i];
+
+        fprintf(f, "  {\"name\": ");
+        json_string(f, job.name);
+        fprintf(f, ", \"firmware\": ");
+        json_string(f, job.firmware);
+        if(!job.error.empty())
+        {
+            fprintf(f, ", \"error\": ");
+            json_string(f, job.error);
+            fprintf(f, "}%s\n", i + 1 < jobs.size() ? "," : "");
+            continue;
+        }
+        fprintf(f, ", \"stop\": \"%s\", \"fault\": %d, \"cycles\": %llu, \"output\": \"",
+            stop_reason_name(job.reason), job.fault, (unsigned long long)job.cycle);
+        for(size_t j = 0; j < job.output.size(); j++)
+        {
+            fprintf(f, "%02x", job.output[j]);
+        }
+        fprintf(f, "\"}%s\n", i + 1 < jobs.size() ? "," : "");
+    }
+    fprintf(f, "]}\n");
+}
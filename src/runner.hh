@@ -0,0 +1,66 @@
+// runner.hh
+
+#ifndef AVRE_RUNNER_HH
+#define AVRE_RUNNER_HH
+
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "machine.hh"
+
+struct Job
+{
+    std::string name;
+    std::string firmware, type, board, input, usart;
+    const FlashImage *image;
+    std::vector<uint8_t> data;
+    StopCondition stop;
+    // set when the job cannot run, which is then all its report says
+    std::string error;
+
+    StopReason reason;
+    int fault;
+    uint64_t cycle;
+    std::vector<uint8_t> output;
+};
+
+// runs the jobs of a manifest on a pool of threads; each thread owns a
+// queue and steals from the back of the others once its own runs dry
+class Runner
+{
+protected:
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<size_t> jobs;
+    };
+
+    std::vector<Job> jobs;
+    std::vector<Queue> queues;
+    // each distinct firmware is parsed once and shared by its jobs
+    std::map<std::string, FlashImage *> images;
+    // the usarts of each board, "" for the default one
+    std::map<std::string, std::set<std::string>> usarts;
+    // jobs run on Instrumented cores, which count I/O accesses for -M
+    bool instrumented;
+
+    void load(Job &job);
+
+    bool next(size_t id, size_t &job);
+    void work(size_t id);
+    void execute(Job &job);
+
+public:
+    Runner(const char *manifest, bool _instrumented);
+    virtual ~Runner();
+
+    void run(unsigned threads);
+    void report(FILE *f);
+};
+
+#endif
@@ -0,0 +1,124 @@
+// symbols.cc
+
+#include <algorithm>
+
+#include "elf.hh"
+#include "symbols.hh"
+
+Symbols::Symbols()
+{
+}
+
+Symbols::Symbols(const char *fn)
+{
+    ElfFile elf(fn);
+    Symbol symbol;
+
+    for(unsigned i = 0; i < elf.header().e_shnum; i++)
+    {
+        const Elf32_Shdr &sh = elf.section(i);
+        if(sh.sh_type != SHT_SYMTAB || sh.sh_entsize != sizeof(Elf32_Sym) || elf.header().e_shnum <= sh.sh_link)
+        {
+            continue;
+        }
+        const Elf32_Shdr &strtab = elf.section(sh.sh_link);
+        const Elf32_Sym *syms = (const Elf32_Sym *)elf.at(sh.sh_offset, sh.sh_size);
+        const char *strs = (const char *)elf.at(strtab.sh_offset, strtab.sh_size);
+
+        for(unsigned j = 0; j < sh.sh_size / sizeof(Elf32_Sym); j++)
+        {
+            if(strtab.sh_size <= syms[j].st_name || strs[syms[j].st_name] == 0)
+            {
+                continue;
+            }
+            // variables and linker-defined markers such as __heap_start,
+            // which are absolute
+            if(ELF_AVR_DATA_BASE <= syms[j].st_value && syms[j].st_value < ELF_AVR_DATA_BASE + 0x10000 &&
+                (ELF32_ST_TYPE(syms[j].st_info) == STT_OBJECT || ELF32_ST_TYPE(syms[j].st_info) == STT_NOTYPE))
+            {
+                symbol.addr = syms[j].st_value - ELF_AVR_DATA_BASE;
+                symbol.size = syms[j].st_size;
+                symbol.name = strs + syms[j].st_name;
+                variables.push_back(symbol);
+                continue;
+            }
+            // functions, and the untyped labels of assembly sources
+            if((ELF32_ST_TYPE(syms[j].st_info) != STT_FUNC && ELF32_ST_TYPE(syms[j].st_info) != STT_NOTYPE) ||
+                syms[j].st_shndx == SHN_UNDEF || elf.header().e_shnum <= syms[j].st_shndx ||
+                ELF_AVR_DATA_BASE <= syms[j].st_value)
+            {
+                continue;
+            }
+            if((elf.section(syms[j].st_shndx).sh_flags & SHF_EXECINSTR) == 0)
+            {
+                continue;
+            }
+            symbol.addr = syms[j].st_value;
+            symbol.size = syms[j].st_size;
+            symbol.name = strs + syms[j].st_name;
+            symbols.push_back(symbol);
+        }
+    }
+
+    // prefer sized symbols (functions) over labels at the same address
+    std::sort(symbols.begin(), symbols.end(),
+        [](const Symbol &a, const Symbol &b)
+        {
+            return a.addr != b.addr ? a.addr < b.addr : a.size > b.size;
+        });
+    symbols.erase(std::unique(symbols.begin(), symbols.end(),
+        [](const Symbol &a, const Symbol &b)
+        {
+            return a.addr == b.addr;
+        }), symbols.end());
+}
+
+bool Symbols::empty() const
+{
+    return symbols.empty();
+}
+
+const Symbol *Symbols::find(uint32_t addr) const
+{
+    std::vector<Symbol>::const_iterator it;
+
+    it = std::upper_bound(symbols.begin(), symbols.end(), addr,
+        [](uint32_t addr, const Symbol &symbol)
+        {
+            return addr < symbol.addr;
+        });
+    if(it == symbols.begin())
+    {
+        return NULL;
+    }
+    --it;
+    if(it->size != 0 && it->addr + it->size <= addr)
+    {
+        return NULL;
+    }
+    return &*it;
+}
+
+const Symbol *Symbols::find(const std::string &name) const
+{
+    for(const Symbol &symbol : symbols)
+    {
+        if(symbol.name == name)
+        {
+            return &symbol;
+        }
+    }
+    return NULL;
+}
+
+const Symbol *Symbols::variable(const std::string &name) const
+{
+    for(const Symbol &symbol : variables)
+    {
+        if(symbol.name == name)
+        {
+            return &symbol;
+        }
+    }
+    return NULL;
+}
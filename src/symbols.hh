@@ -0,0 +1,39 @@
+// symbols.hh
+
+#ifndef AVRE_SYMBOLS_HH
+#define AVRE_SYMBOLS_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Symbol
+{
+    // byte addresses in flash
+    uint32_t addr;
+    uint32_t size;
+    std::string name;
+};
+
+// the code symbols of an ELF file, sorted by address, and its data
+// symbols by name
+class Symbols
+{
+protected:
+    std::vector<Symbol> symbols;
+    // data space addresses, without the 0x800000 offset of the ELF
+    std::vector<Symbol> variables;
+
+public:
+    Symbols();
+    Symbols(const char *fn);
+
+    bool empty() const;
+    // the symbol covering the byte address; one without a size reaches
+    // up to the next symbol
+    const Symbol *find(uint32_t addr) const;
+    const Symbol *find(const std::string &name) const;
+    const Symbol *variable(const std::string &name) const;
+};
+
+#endif
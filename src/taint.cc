@@ -0,0 +1,164 @@
+// taint.cc
+
+#include <cstring>
+
+#include "decoder.hh"
+#include "taint.hh"
+
+struct TaintRule
+{
+    const char *name;
+    uint16_t rule;
+    // the pointer register pair, for loads, stores and LPM
+    uint8_t pointer;
+};
+
+// the opcodes not listed only move data: their writes carry the taint of
+// their reads and SREG is left alone
+static const TaintRule taint_rules[] = {
+    {"ADC", TAINT_FLAGS | TAINT_CARRY, 0},
+    {"ADD", TAINT_FLAGS, 0},
+    {"ADIW", TAINT_FLAGS, 0},
+    {"AND", TAINT_FLAGS, 0},
+    {"ANDI", TAINT_FLAGS, 0},
+    {"ASR", TAINT_FLAGS, 0},
+    {"BLD", TAINT_CARRY, 0},
+    {"BRBC", TAINT_BRANCH, 0},
+    {"BRBS", TAINT_BRANCH, 0},
+    {"BST", TAINT_FLAGS, 0},
+    {"COM", TAINT_FLAGS, 0},
+    {"CP", TAINT_FLAGS | TAINT_SAME, 0},
+    {"CPC", TAINT_FLAGS | TAINT_CARRY, 0},
+    {"CPI", TAINT_FLAGS, 0},
+    {"CPSE", TAINT_SKIP, 0},
+    {"DEC", TAINT_FLAGS, 0},
+    {"EICALL", TAINT_INDIRECT, 0},
+    {"EIJMP", TAINT_INDIRECT, 0},
+    {"ELPM_1", TAINT_TABLE, AVR_REG_Z},
+    {"ELPM_2", TAINT_TABLE, AVR_REG_Z},
+    {"ELPM_3", TAINT_TABLE, AVR_REG_Z},
+    {"EOR", TAINT_FLAGS | TAINT_SAME, 0},
+    {"FMUL", TAINT_FLAGS, 0},
+    {"FMULS", TAINT_FLAGS, 0},
+    {"FMULSU", TAINT_FLAGS, 0},
+    {"ICALL", TAINT_INDIRECT, 0},
+    {"IJMP", TAINT_INDIRECT, 0},
+    {"INC", TAINT_FLAGS, 0},
+    {"LD_X1", TAINT_LOAD, AVR_REG_X},
+    {"LD_X2", TAINT_LOAD, AVR_REG_X},
+    {"LD_X3", TAINT_LOAD, AVR_REG_X},
+    {"LD_Y2", TAINT_LOAD, AVR_REG_Y},
+    {"LD_Y3", TAINT_LOAD, AVR_REG_Y},
+    {"LD_Y4", TAINT_LOAD, AVR_REG_Y},
+    {"LD_Z2", TAINT_LOAD, AVR_REG_Z},
+    {"LD_Z3", TAINT_LOAD, AVR_REG_Z},
+    {"LD_Z4", TAINT_LOAD, AVR_REG_Z},
+    {"LPM_1", TAINT_TABLE, AVR_REG_Z},
+    {"LPM_2", TAINT_TABLE, AVR_REG_Z},
+    {"LPM_3", TAINT_TABLE, AVR_REG_Z},
+    {"LSR", TAINT_FLAGS, 0},
+    {"MUL", TAINT_FLAGS, 0},
+    {"MULS", TAINT_FLAGS, 0},
+    {"MULSU", TAINT_FLAGS, 0},
+    {"NEG", TAINT_FLAGS, 0},
+    {"OR", TAINT_FLAGS, 0},
+    {"ORI", TAINT_FLAGS, 0},
+    {"RET", TAINT_INDIRECT, 0},
+    {"RETI", TAINT_INDIRECT, 0},
+    {"ROR", TAINT_FLAGS | TAINT_CARRY, 0},
+    {"SBC", TAINT_FLAGS | TAINT_CARRY, 0},
+    {"SBCI", TAINT_FLAGS | TAINT_CARRY, 0},
+    {"SBIC", TAINT_SKIP, 0},
+    {"SBIS", TAINT_SKIP, 0},
+    {"SBIW", TAINT_FLAGS, 0},
+    {"SBRC", TAINT_SKIP, 0},
+    {"SBRS", TAINT_SKIP, 0},
+    {"ST_X1", TAINT_STORE, AVR_REG_X},
+    {"ST_X2", TAINT_STORE, AVR_REG_X},
+    {"ST_X3", TAINT_STORE, AVR_REG_X},
+    {"ST_Y2", TAINT_STORE, AVR_REG_Y},
+    {"ST_Y3", TAINT_STORE, AVR_REG_Y},
+    {"ST_Y4", TAINT_STORE, AVR_REG_Y},
+    {"ST_Z2", TAINT_STORE, AVR_REG_Z},
+    {"ST_Z3", TAINT_STORE, AVR_REG_Z},
+    {"ST_Z4", TAINT_STORE, AVR_REG_Z},
+    {"SUB", TAINT_FLAGS | TAINT_SAME, 0},
+    {"SUBI", TAINT_FLAGS, 0},
+};
+
+static const char *const event_names[] = {"branch", "indirect", "stack"};
+
+TaintHooks::TaintHooks()
+    : address(false), rule(0), pointer(0), exec_pc(0), value(0), base(0), pointer_reads(0), writes(0)
+{
+    memset(shadow, 0, sizeof(shadow));
+    memset(sources, 0, sizeof(sources));
+    memset(rules, 0, sizeof(rules));
+    memset(pointers, 0, sizeof(pointers));
+    for(const TaintRule &r : taint_rules)
+    {
+        for(unsigned i = 0; i < OPCODE_COUNT; i++)
+        {
+            if(strcmp(r.name, opcodes[i].name) == 0)
+            {
+                rules[i] = r.rule;
+                pointers[i] = r.pointer;
+            }
+        }
+    }
+}
+
+uint32_t TaintHooks::tainted() const
+{
+    uint32_t n = 0;
+    uint8_t t;
+
+    for(uint32_t i = 0; i < SRAM_SIZE_BYTES; i++)
+    {
+        t = taint(i);
+        // a source itself does not count
+        if(i < REGS_SIZE_BYTES)
+        {
+            t &= ~sources[i];
+        }
+        n += t != 0;
+    }
+    return n;
+}
+
+void TaintHooks::report(FILE *f, const AVR *avr, const Symbols &symbols) const
+{
+    Instruction inst;
+    const Symbol *symbol;
+    char text[128], where[160];
+    int last = -1;
+
+    for(std::map<std::pair<int, uint16_t>, TaintSite>::const_iterator it = sites.begin(); it != sites.end(); it++)
+    {
+        uint16_t pc = it->first.second;
+
+        if(it->first.first != last)
+        {
+            last = it->first.first;
+            fprintf(f, "%s:\n", event_names[last]);
+        }
+        Instruction::decode(inst, pc, avr->flash.words[pc], avr->flash.words[(uint16_t)(pc + 1)]);
+        inst.format(text, sizeof(text), &symbols);
+        symbol = symbols.find((uint32_t)pc << 1);
+        if(symbol != NULL)
+        {
+            snprintf(where, sizeof(where), " <%s+0x%x>", symbol->name.c_str(), ((uint32_t)pc << 1) - symbol->addr);
+        }
+        else
+        {
+            where[0] = 0;
+        }
+        fprintf(f, "  %05x%s %llu times, first at cycle %llu, labels %02x: %s\n", (uint32_t)pc << 1, where,
+            (unsigned long long)it->second.count, (unsigned long long)it->second.cycle, it->second.labels, text);
+    }
+    if(sites.empty())
+    {
+        fprintf(f, "no tainted branches, indirect jumps or stack writes\n");
+    }
+    fprintf(f, "%u bytes tainted\n", tainted());
+}
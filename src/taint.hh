@@ -0,0 +1,207 @@
+// taint.hh
+
+#ifndef AVRE_TAINT_HH
+#define AVRE_TAINT_HH
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+
+#include "avr.hh"
+#include "hooks.hh"
+#include "opcode.hh"
+#include "symbols.hh"
+
+// what an instruction does with the taint of what it reads
+#define TAINT_FLAGS    (0x001u) // the result's taint is SREG's too
+#define TAINT_CARRY    (0x002u) // SREG's taint is part of the result
+#define TAINT_SAME     (0x004u) // the result is clean when Rd is Rr
+#define TAINT_SKIP     (0x008u) // a skip on what it reads
+#define TAINT_BRANCH   (0x010u) // a branch on SREG
+#define TAINT_INDIRECT (0x020u) // a jump, call or return to an address read
+#define TAINT_LOAD     (0x040u) // LD through a pointer register pair
+#define TAINT_STORE    (0x080u) // ST through a pointer register pair
+#define TAINT_TABLE    (0x100u) // LPM and ELPM, flash indexed by Z
+// set for one instruction found to clear its result, eor r1, r1 say
+#define TAINT_CLEAN    (0x200u)
+
+#define TAINT_POINTER  (TAINT_LOAD | TAINT_STORE | TAINT_TABLE)
+
+enum TaintEvent
+{
+    TAINT_EVENT_BRANCH,     // a branch or skip decided by tainted data
+    TAINT_EVENT_INDIRECT,   // IJMP, ICALL or RET to a tainted address
+    TAINT_EVENT_STACK,      // tainted data written to the stack
+};
+
+struct TaintSite
+{
+    uint64_t count;
+    uint64_t cycle;
+    // the labels of the first time
+    uint8_t labels;
+};
+
+// the hook set of Engine<TaintHooks>: a shadow byte per data space byte
+// holding the labels of the sources it was computed from, none for clean
+// data. Reading a source's I/O address, such as a USART's UDR, yields
+// its label; otherwise an instruction's result carries the union of the
+// taint of what it read, with the exceptions its rule makes: a load
+// takes its data's taint but not its pointer's unless address is set,
+// LPM takes Z's since the flash it reads is a function of it, and
+// pointer increments keep their own. SREG is one shadow byte for all
+// flags. Other I/O registers read as clean, the peripheral behind them
+// being free to change them
+struct TaintHooks : NoHooks
+{
+    uint8_t shadow[SRAM_SIZE_BYTES];
+    uint8_t sources[REGS_SIZE_BYTES];
+    bool address;
+    // by event and word pc
+    std::map<std::pair<int, uint16_t>, TaintSite> sites;
+
+    // the instruction under way
+    uint16_t rule;
+    uint16_t pointer;
+    uint16_t exec_pc;
+    uint8_t value;
+    uint8_t base;
+    uint8_t pointer_reads;
+    uint8_t writes;
+
+    // by opcode index
+    uint16_t rules[OPCODE_COUNT];
+    uint8_t pointers[OPCODE_COUNT];
+
+    TaintHooks();
+
+    // reads of addr are tainted with label, one bit per source
+    void add_source(uint16_t addr, uint8_t label)
+    {
+        sources[addr] |= label;
+    }
+
+    uint8_t taint(uint16_t addr) const
+    {
+        if(AVR_IO_START <= addr && addr < REGS_SIZE_BYTES)
+        {
+            return sources[addr] | (addr == AVR_REG_SREG || addr == AVR_REG_SPL || addr == AVR_REG_SPH || addr == AVR_REG_RAMPZ ? shadow[addr] : 0);
+        }
+        return shadow[addr];
+    }
+
+    // the flags of the last instruction are only known to be set once it
+    // is over
+    void retire()
+    {
+        if(rule & TAINT_FLAGS)
+        {
+            shadow[AVR_REG_SREG] = rule & TAINT_CLEAN ? 0 : value;
+        }
+        rule = 0;
+        value = 0;
+        base = 0;
+        pointer_reads = 0;
+        writes = 0;
+    }
+
+    void event(const AVR *avr, int kind, uint8_t labels)
+    {
+        TaintSite &site = sites[std::make_pair(kind, exec_pc)];
+
+        if(site.count++ == 0)
+        {
+            site.cycle = avr->cycle;
+            site.labels = labels;
+        }
+    }
+
+    void on_exec(AVR *avr, uint16_t pc)
+    {
+        uint16_t inst = avr->flash.words[pc];
+        const Opcode *op = Opcode::find(inst);
+
+        retire();
+        exec_pc = pc;
+        if(op == NULL)
+        {
+            return;
+        }
+        rule = rules[op - opcodes];
+        pointer = pointers[op - opcodes];
+        if((rule & TAINT_SAME) && ((inst >> 4) & 0x1f) == ((inst & 0xf) | ((inst >> 5) & 0x10)))
+        {
+            rule |= TAINT_CLEAN;
+        }
+        if(rule & TAINT_CARRY)
+        {
+            value = shadow[AVR_REG_SREG];
+        }
+    }
+
+    // the return address pushed is clean
+    void on_irq(AVR *avr, int num)
+    {
+        retire();
+    }
+
+    void on_mem_read(AVR *avr, uint16_t addr, uint8_t data)
+    {
+        // the first two reads of the pointer pair are its address
+        if((rule & TAINT_POINTER) && pointer_reads < 2 && (addr == pointer || addr == pointer + 1))
+        {
+            pointer_reads++;
+            base |= taint(addr);
+            return;
+        }
+        value |= taint(addr);
+    }
+
+    void on_mem_write(AVR *avr, uint16_t addr, uint8_t data)
+    {
+        uint8_t t = rule & (TAINT_CLEAN | TAINT_INDIRECT) ? 0 : value;
+
+        if(rule & TAINT_POINTER)
+        {
+            // the data comes first, then the pointer moving on
+            if(writes++ != 0)
+            {
+                return;
+            }
+            if((rule & TAINT_TABLE) || ((rule & TAINT_LOAD) && address))
+            {
+                t |= base;
+            }
+        }
+        if(t != 0 && REGS_SIZE_BYTES <= avr->sp && avr->sp <= addr)
+        {
+            event(avr, TAINT_EVENT_STACK, t);
+        }
+        shadow[addr] = t;
+    }
+
+    void on_branch(AVR *avr, uint16_t from, uint16_t to)
+    {
+        if((rule & TAINT_SKIP) && value != 0)
+        {
+            event(avr, TAINT_EVENT_BRANCH, value);
+        }
+        else if((rule & TAINT_BRANCH) && shadow[AVR_REG_SREG] != 0)
+        {
+            event(avr, TAINT_EVENT_BRANCH, shadow[AVR_REG_SREG]);
+        }
+        else if((rule & TAINT_INDIRECT) && value != 0)
+        {
+            event(avr, TAINT_EVENT_INDIRECT, value);
+        }
+    }
+
+    // the bytes of data space tainted now
+    uint32_t tainted() const;
+
+    // every site by event, with its instruction and, with symbols, the
+    // function it is in
+    void report(FILE *f, const AVR *avr, const Symbols &symbols) const;
+};
+
+#endif
@@ -0,0 +1,231 @@
+// timeline.cc
+
+#include <algorithm>
+#include <cstring>
+
+#include "timeline.hh"
+
+static void put(std::vector<uint8_t> &out, uint64_t value)
+{
+    while(0x80 <= value)
+    {
+        out.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(value);
+}
+
+static uint64_t get(const uint8_t *&in)
+{
+    uint64_t value = 0;
+    unsigned shift = 0;
+
+    while(*in & 0x80)
+    {
+        value |= (uint64_t)(*in++ & 0x7f) << shift;
+        shift += 7;
+    }
+    return value | (uint64_t)*in++ << shift;
+}
+
+// cur ^ prev with the zero runs squeezed out; prev NULL stands for zero
+static void encode(const uint8_t *cur, const uint8_t *prev, std::vector<uint8_t> &out)
+{
+    size_t i = 0, run, lit;
+
+    while(i < SRAM_SIZE_BYTES)
+    {
+        for(run = 0; i + run < SRAM_SIZE_BYTES && cur[i + run] == (prev == NULL ? 0 : prev[i + run]); run++);
+        i += run;
+        for(lit = 0; i + lit < SRAM_SIZE_BYTES && cur[i + lit] != (prev == NULL ? 0 : prev[i + lit]); lit++);
+        put(out, run);
+        put(out, lit);
+        for(size_t k = 0; k < lit; k++)
+        {
+            out.push_back(cur[i + k] ^ (prev == NULL ? 0 : prev[i + k]));
+        }
+        i += lit;
+    }
+}
+
+// XORs a delta made by encode() into dst
+static void decode(const std::vector<uint8_t> &delta, uint8_t *dst)
+{
+    const uint8_t *in = delta.data(), *end = delta.data() + delta.size();
+    size_t i = 0, lit;
+
+    while(in < end)
+    {
+        i += get(in);
+        lit = get(in);
+        while(lit--)
+        {
+            dst[i++] ^= *in++;
+        }
+    }
+}
+
+Timeline::Timeline(Machine *_machine, Journal *_journal, uint64_t _interval)
+    : machine(_machine), journal(_journal), interval(_interval), last(new SRAM()), work(new Snapshot()), steps(0)
+{
+}
+
+Timeline::~Timeline()
+{
+    delete last;
+    delete work;
+}
+
+void Timeline::checkpoint()
+{
+    Checkpoint cp;
+    bool key = checkpoints.size() % TIMELINE_KEY_EVERY == 0;
+
+    machine->avr->snapshot(*work);
+    cp.steps = steps;
+    cp.journal = journal == NULL ? 0 : journal->position();
+    cp.pc = work->pc;
+    cp.cycle = work->cycle;
+    cp.fault = work->fault;
+    cp.sleeping = work->sleeping;
+    cp.stack_low = work->stack_low;
+    cp.irq = work->irq;
+    cp.modules = work->modules;
+    encode(work->sram.bytes, key ? NULL : last->bytes, cp.sram);
+    cp.sram.shrink_to_fit();
+    memcpy(last->bytes, work->sram.bytes, SRAM_SIZE_BYTES);
+    checkpoints.push_back(std::move(cp));
+}
+
+void Timeline::load(size_t index)
+{
+    const Checkpoint &cp = checkpoints[index];
+
+    memset(work->sram.bytes, 0, SRAM_SIZE_BYTES);
+    for(size_t i = index - index % TIMELINE_KEY_EVERY; i <= index; i++)
+    {
+        decode(checkpoints[i].sram, work->sram.bytes);
+    }
+    work->id = 0;
+    work->pc = cp.pc;
+    work->cycle = cp.cycle;
+    work->fault = cp.fault;
+    work->sleeping = cp.sleeping;
+    work->stack_low = cp.stack_low;
+    work->irq = cp.irq;
+    work->modules = cp.modules;
+    machine->avr->restore(*work);
+
+    steps = cp.steps;
+    if(journal != NULL)
+    {
+        journal->seek(cp.journal);
+    }
+}
+
+size_t Timeline::find(uint64_t target) const
+{
+    std::vector<Checkpoint>::const_iterator it;
+
+    it = std::upper_bound(checkpoints.begin(), checkpoints.end(), target,
+        [](uint64_t target, const Checkpoint &cp)
+        {
+            return target < cp.steps;
+        });
+    return it - checkpoints.begin() - 1;
+}
+
+void Timeline::step()
+{
+    if(checkpoints.empty() || (checkpoints.back().steps < steps && checkpoints.back().cycle + interval <= machine->avr->cycle))
+    {
+        checkpoint();
+    }
+    machine->process();
+    steps++;
+}
+
+void Timeline::seek(uint64_t target)
+{
+    if(target < steps)
+    {
+        load(find(target));
+    }
+    while(steps < target)
+    {
+        step();
+    }
+}
+
+bool Timeline::step_back(uint64_t count)
+{
+    if(steps < count)
+    {
+        return false;
+    }
+    seek(steps - count);
+    return true;
+}
+
+bool Timeline::search_back(const std::function<bool(bool)> &hit)
+{
+    uint64_t start = steps, end = steps, found = UINT64_MAX;
+    size_t i;
+
+    if(steps == 0)
+    {
+        return false;
+    }
+
+    // scan one checkpoint interval at a time, latest first
+    for(i = find(steps - 1); ; i--)
+    {
+        load(i);
+        while(steps < end)
+        {
+            machine->avr->watched = false;
+            if(hit(false))
+            {
+                found = steps;
+            }
+            step();
+            if(hit(true))
+            {
+                found = steps - 1;
+            }
+        }
+        if(found != UINT64_MAX || i == 0)
+        {
+            break;
+        }
+        end = checkpoints[i].steps;
+    }
+    seek(found == UINT64_MAX ? start : found);
+    return found != UINT64_MAX;
+}
+
+bool Timeline::last_write(uint16_t addr)
+{
+    AVR *avr = machine->avr;
+    bool found;
+    int id;
+
+    id = avr->add_watch(addr, 1, WATCH_WRITE, -1);
+    found = search_back([avr](bool after)
+        {
+            return after && avr->watched;
+        });
+    avr->remove_watch(id);
+    return found;
+}
+
+size_t Timeline::footprint() const
+{
+    size_t size = 0;
+
+    for(const Checkpoint &cp : checkpoints)
+    {
+        size += sizeof(cp) + cp.modules.size() + cp.sram.size();
+    }
+    return size;
+}
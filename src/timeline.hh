@@ -0,0 +1,77 @@
+// timeline.hh
+
+#ifndef AVRE_TIMELINE_HH
+#define AVRE_TIMELINE_HH
+
+#include <functional>
+#include <vector>
+
+#include "journal.hh"
+#include "machine.hh"
+
+// default cycles between checkpoints, about 65ms at 16MHz
+#define TIMELINE_INTERVAL (0x100000u)
+// every so many checkpoints one is stored against zero instead of its
+// predecessor, bounding the chain a restore has to walk
+#define TIMELINE_KEY_EVERY (64u)
+
+struct Checkpoint
+{
+    uint64_t steps;
+    size_t journal;
+    uint16_t pc;
+    uint64_t cycle;
+    int fault;
+    bool sleeping;
+    uint16_t stack_low;
+    uint64_t irq;
+    std::vector<uint8_t> modules;
+    // SRAM XORed with the previous checkpoint's (or with zero at a key),
+    // as pairs of zero-run and literal lengths, LEB128, each followed by
+    // its literal bytes
+    std::vector<uint8_t> sram;
+};
+
+// runs the machine one step at a time, taking a checkpoint every interval
+// cycles, and moves back by restoring the nearest one and running forward
+// again; that only retraces the same path when the run is deterministic,
+// so USART input has to come through the journal (or from memory)
+class Timeline
+{
+protected:
+    Machine *machine;
+    Journal *journal;
+    uint64_t interval;
+    std::vector<Checkpoint> checkpoints;
+    // SRAM as of the latest checkpoint
+    struct SRAM *last;
+    Snapshot *work;
+
+    void checkpoint();
+    void load(size_t index);
+    size_t find(uint64_t target) const;
+
+public:
+    // instructions (and interrupt entries) since reset
+    uint64_t steps;
+
+    Timeline(Machine *_machine, Journal *_journal, uint64_t _interval);
+    ~Timeline();
+
+    void step();
+    // moves to any earlier step
+    void seek(uint64_t target);
+    bool step_back(uint64_t count);
+    // moves back to the latest earlier step, about to run, for which hit()
+    // holds; it is asked with the step about to run (false) and again
+    // once it has run (true), when AVR::watched tells whether it
+    // triggered a watchpoint; with none found it stays where it is
+    bool search_back(const std::function<bool(bool)> &hit);
+    // moves back to the instruction that last wrote addr, about to run
+    bool last_write(uint16_t addr);
+
+    // bytes held by the checkpoints
+    size_t footprint() const;
+};
+
+#endif
@@ -0,0 +1,142 @@
+// timer.cc
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "timer.hh"
+
+REGISTER_MODULE("timer", Timer);
+
+// log2 of the prescaler per clock select value, Timer0's set: 1, 8, 32,
+// 64, 128, 256 and 1024
+static const uint8_t prescaler_shift[TIMER_CS_MASK + 1] = {0, 0, 3, 5, 6, 7, 8, 10};
+
+static int irq_number(const ModuleConfig &config, const char *key)
+{
+    uint32_t num = config.get_uint(key);
+    if(IRQ_COUNT <= num)
+    {
+        fprintf(stderr, "%s: %s: no such interrupt vector -- '%s=%u'\n", config.where.c_str(), config.name.c_str(), key, num);
+        exit(1);
+    }
+    return num;
+}
+
+Timer::Timer(AVR *_avr, const ModuleConfig &config)
+    : avr(_avr),
+      TCNT(config.get_uint("tcnt")), TCCR(config.get_uint("tccr")), TIMSK(config.get_uint("timsk")), TIFR(config.get_uint("tifr")),
+      OVF(irq_number(config, "ovf"))
+{
+}
+
+Timer::~Timer()
+{
+}
+
+void Timer::initialize()
+{
+    tcnt = tccr = timsk = tifr = 0;
+    residue = 0;
+    raised = false;
+    last = avr->cycle;
+
+    avr->register_handler(TCNT,
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return tcnt;
+        },
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return tcnt = data;
+        });
+    avr->register_handler(TCCR,
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return tccr;
+        },
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return tccr = data;
+        });
+    avr->register_handler(TIMSK,
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return timsk;
+        },
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return timsk = data;
+        });
+    // flags are cleared by writing ones
+    avr->register_handler(TIFR,
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            return tifr;
+        },
+        [this](AVR *avr, uint16_t reg, uint8_t data)
+        {
+            tifr &= ~data;
+            return tifr;
+        });
+}
+
+void Timer::process()
+{
+    uint32_t ticks;
+    uint8_t shift;
+
+    // taken since the last step
+    if(raised && !avr->pending(OVF))
+    {
+        tifr &= ~TIMER_TOV;
+        raised = false;
+    }
+    if((tccr & TIMER_CS_MASK) == 0)
+    {
+        last = avr->cycle;
+        return;
+    }
+    shift = prescaler_shift[tccr & TIMER_CS_MASK];
+    ticks = (uint32_t)(avr->cycle - last) + residue;
+    last = avr->cycle;
+    residue = ticks & ((1u << shift) - 1);
+    ticks = (ticks >> shift) + tcnt;
+    tcnt = ticks & 0xff;
+    if(0xff < ticks)
+    {
+        tifr |= TIMER_TOV;
+        if(timsk & TIMER_TOIE)
+        {
+            avr->raise_irq(OVF);
+            raised = true;
+        }
+    }
+}
+
+size_t Timer::state_size()
+{
+    return 7;
+}
+
+void Timer::save(uint8_t *state)
+{
+    state[0] = tcnt;
+    state[1] = tccr;
+    state[2] = timsk;
+    state[3] = tifr;
+    state[4] = residue & 0xff;
+    state[5] = residue >> 8;
+    state[6] = raised;
+}
+
+void Timer::load(const uint8_t *state)
+{
+    tcnt = state[0];
+    tccr = state[1];
+    timsk = state[2];
+    tifr = state[3];
+    residue = state[4] | state[5] << 8;
+    raised = state[6];
+    // the core's cycle count has been restored already
+    last = avr->cycle;
+}
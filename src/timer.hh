@@ -0,0 +1,41 @@
+// timer.hh
+
+#ifndef AVRE_TIMER_HH
+#define AVRE_TIMER_HH
+
+#include "avr.hh"
+#include "registry.hh"
+
+#define TIMER_CS_MASK (0x07u)
+#define TIMER_TOV     (0x01u)
+#define TIMER_TOIE    (0x01u)
+
+// an 8-bit timer in normal mode, counting up from the core's cycle count
+// and raising the overflow interrupt, whose entry clears TOV as on the
+// chip; compare match and PWM are not modelled. It owns TIMSK and TIFR,
+// so a board has at most one
+class Timer : public Module
+{
+protected:
+    AVR *avr;
+    uint8_t tcnt, tccr, timsk, tifr;
+    // cycles not yet worth a tick at the current prescaler
+    uint16_t residue;
+    // the overflow interrupt was raised and is yet to be taken
+    bool raised;
+    uint64_t last;
+    uint16_t TCNT, TCCR, TIMSK, TIFR, OVF;
+
+public:
+    Timer(AVR *_avr, const ModuleConfig &config);
+    virtual ~Timer();
+
+    virtual void initialize();
+    virtual void process();
+
+    virtual size_t state_size();
+    virtual void save(uint8_t *state);
+    virtual void load(const uint8_t *state);
+};
+
+#endif
@@ -0,0 +1,200 @@
+// trace.cc
+
+#include <cstdlib>
+#include <cstring>
+
+#include "trace.hh"
+
+Trace::Trace(const char *fn, bool _writes)
+    : ring(TRACE_CHUNK_SIZE * TRACE_CHUNKS), pos(0), last_pc(0), sync(1), closing(false), writes(_writes)
+{
+    uint8_t flags = writes ? TRACE_FLAG_WRITES : 0;
+
+    f = fopen(fn, "wb");
+    if(f == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    fwrite(TRACE_MAGIC, 1, TRACE_MAGIC_SIZE, f);
+    fwrite(&flags, 1, 1, f);
+
+    chunk = ring.data();
+    for(unsigned i = 1; i < TRACE_CHUNKS; i++)
+    {
+        spare.push_back(ring.data() + i * TRACE_CHUNK_SIZE);
+    }
+    flusher = std::thread(&Trace::flush_loop, this);
+}
+
+Trace::~Trace()
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        closing = true;
+        changed.notify_all();
+    }
+    flusher.join();
+
+    fwrite(chunk, 1, pos, f);
+    fclose(f);
+}
+
+void Trace::flush_loop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    uint8_t *out;
+
+    while(true)
+    {
+        changed.wait(guard,
+            [this]()
+            {
+                return closing || !full.empty();
+            });
+        if(full.empty())
+        {
+            return;
+        }
+        out = full.front();
+        full.pop_front();
+
+        guard.unlock();
+        if(fwrite(out, 1, TRACE_CHUNK_SIZE, f) != TRACE_CHUNK_SIZE)
+        {
+            perror("trace");
+            exit(1);
+        }
+        guard.lock();
+
+        spare.push_back(out);
+        changed.notify_all();
+    }
+}
+
+void Trace::next_chunk()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    full.push_back(chunk);
+    changed.notify_all();
+    changed.wait(guard,
+        [this]()
+        {
+            return !spare.empty();
+        });
+    chunk = spare.front();
+    spare.pop_front();
+    pos = 0;
+}
+
+void Trace::put_uint(uint64_t value)
+{
+    while(0x80 <= value)
+    {
+        put((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    put(value);
+}
+
+void Trace::cycles(uint64_t cycle)
+{
+    put(TRACE_TAG_CYCLE);
+    put_uint(cycle);
+    sync = TRACE_SYNC_STEPS;
+}
+
+TraceReader::TraceReader(const char *fn)
+    : steps(0), pc(0), flags(0)
+{
+    char magic[TRACE_MAGIC_SIZE];
+
+    f = fopen(fn, "rb");
+    if(f == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    if(fread(magic, 1, TRACE_MAGIC_SIZE, f) != TRACE_MAGIC_SIZE || memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_SIZE) != 0 || fread(&flags, 1, 1, f) != 1)
+    {
+        fprintf(stderr, "%s: not a trace\n", fn);
+        exit(1);
+    }
+}
+
+TraceReader::~TraceReader()
+{
+    fclose(f);
+}
+
+bool TraceReader::get_uint(uint64_t &value)
+{
+    unsigned shift = 0;
+    int ch;
+
+    value = 0;
+    while((ch = getc(f)) != EOF)
+    {
+        value |= (uint64_t)(ch & 0x7f) << shift;
+        if((ch & 0x80) == 0)
+        {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+bool TraceReader::next(TraceRecord &record)
+{
+    uint64_t value;
+    int tag, ch;
+
+    tag = getc(f);
+    record.step = steps;
+    switch(tag)
+    {
+    case EOF:
+        return false;
+    case TRACE_TAG_PC:
+        if(!get_uint(value))
+        {
+            return false;
+        }
+        pc = value;
+        record.kind = TRACE_STEP;
+        record.pc = pc;
+        steps++;
+        return true;
+    case TRACE_TAG_WRITE:
+        if(!get_uint(value) || (ch = getc(f)) == EOF)
+        {
+            return false;
+        }
+        record.kind = TRACE_WRITE;
+        record.pc = pc;
+        record.addr = value;
+        record.data = ch;
+        return true;
+    case TRACE_TAG_CYCLE:
+        if(!get_uint(value))
+        {
+            return false;
+        }
+        record.kind = TRACE_CYCLE;
+        record.cycle = value;
+        return true;
+    default:
+        if(0x80 <= tag)
+        {
+            fprintf(stderr, "trace: unknown record %02x after step %llu\n", tag, (unsigned long long)steps);
+            exit(1);
+        }
+        pc += tag - 0x40;
+        record.kind = TRACE_STEP;
+        record.pc = pc;
+        steps++;
+        return true;
+    }
+}
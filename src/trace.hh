@@ -0,0 +1,144 @@
+// trace.hh
+
+#ifndef AVRE_TRACE_HH
+#define AVRE_TRACE_HH
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// file layout: TRACE_MAGIC, a flags byte (TRACE_FLAG_*), then records
+// starting with a tag byte:
+//   0x00-0x7f  step to word address pc = previous pc + tag - 0x40
+//   0x80 pc    step to word address pc, LEB128
+//   0x81 a d   write of byte d to data address a, LEB128 a
+//   0x82 c     the cycle count before the next step, LEB128
+// the previous pc starts at 0; a cycle record opens the trace, follows
+// every TRACE_SYNC_STEPS steps and closes it
+#define TRACE_MAGIC "AVRETRC1"
+#define TRACE_MAGIC_SIZE (8u)
+
+#define TRACE_FLAG_WRITES (0x01u)
+
+#define TRACE_TAG_PC    (0x80u)
+#define TRACE_TAG_WRITE (0x81u)
+#define TRACE_TAG_CYCLE (0x82u)
+
+#define TRACE_SYNC_STEPS (0x10000u)
+
+// the ring is TRACE_CHUNKS chunks of TRACE_CHUNK_SIZE bytes each
+#define TRACE_CHUNK_SIZE (0x10000u)
+#define TRACE_CHUNKS     (16u)
+
+// records the pc of every step (and with writes, every store to SRAM
+// above the register file) into a ring of chunks; a full chunk is written
+// out by a background thread while the core fills the next one, and the
+// core only waits when all of them are queued
+class Trace
+{
+protected:
+    FILE *f;
+    std::vector<uint8_t> ring;
+    uint8_t *chunk;
+    size_t pos;
+    uint16_t last_pc;
+    uint32_t sync;
+
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<uint8_t *> full, spare;
+    bool closing;
+    std::thread flusher;
+
+    void flush_loop();
+    void next_chunk();
+    void put_uint(uint64_t value);
+
+    void put(uint8_t byte)
+    {
+        if(pos == TRACE_CHUNK_SIZE)
+        {
+            next_chunk();
+        }
+        chunk[pos++] = byte;
+    }
+
+public:
+    const bool writes;
+
+    Trace(const char *fn, bool _writes);
+    // writes out what is buffered
+    ~Trace();
+
+    void step(uint16_t pc, uint64_t cycle)
+    {
+        int delta = (int)pc - (int)last_pc;
+
+        if(--sync == 0)
+        {
+            cycles(cycle);
+        }
+        if(-0x40 <= delta && delta < 0x40)
+        {
+            put(0x40 + delta);
+        }
+        else
+        {
+            put(TRACE_TAG_PC);
+            put_uint(pc);
+        }
+        last_pc = pc;
+    }
+
+    void write(uint16_t addr, uint8_t data)
+    {
+        put(TRACE_TAG_WRITE);
+        put_uint(addr);
+        put(data);
+    }
+
+    void cycles(uint64_t cycle);
+};
+
+enum TraceKind
+{
+    TRACE_STEP,
+    TRACE_WRITE,
+    TRACE_CYCLE,
+};
+
+struct TraceRecord
+{
+    TraceKind kind;
+    // steps before this record
+    uint64_t step;
+    uint16_t pc;
+    uint16_t addr;
+    uint8_t data;
+    uint64_t cycle;
+};
+
+class TraceReader
+{
+protected:
+    FILE *f;
+    uint64_t steps;
+    uint16_t pc;
+
+    bool get_uint(uint64_t &value);
+
+public:
+    uint8_t flags;
+
+    TraceReader(const char *fn);
+    ~TraceReader();
+
+    // false at the end of the trace
+    bool next(TraceRecord &record);
+};
+
+#endif
@@ -1,22 +1,43 @@
 // usart.cc
 
-#include <sys/time.h>
-#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
 
 #include "usart.hh"
 
-USART::USART(AVR *_avr, int _ifd, int _ofd, uint16_t _UDR, uint16_t _UCSRA, uint16_t _UCSRB, uint16_t _UCSRC, int _RXC, int _DRE, int _TXC)
-    : avr(_avr), ifd(_ifd), ofd(_ofd), UDR(_UDR), UCSRA(_UCSRA), UCSRB(_UCSRB), UCSRC(_UCSRC), RXC(_RXC), DRE(_DRE), TXC(_TXC)
+REGISTER_MODULE("usart", USART);
+
+static int irq_number(const ModuleConfig &config, const char *key)
 {
+    uint32_t num = config.get_uint(key);
+    if(IRQ_COUNT <= num)
+    {
+        fprintf(stderr, "%s: %s: no such interrupt vector -- '%s=%u'\n", config.where.c_str(), config.name.c_str(), key, num);
+        exit(1);
+    }
+    return num;
+}
+
+USART::USART(AVR *_avr, const ModuleConfig &config)
+    : avr(_avr),
+      UDR(config.get_uint("udr")), UCSRA(config.get_uint("ucsra")), UCSRB(config.get_uint("ucsrb")), UCSRC(config.get_uint("ucsrc")),
+      RXC(irq_number(config, "rxc")), DRE(irq_number(config, "dre")), TXC(irq_number(config, "txc"))
+{
+    backend = Backend::open(config.get_string("rx"), config.get_string("tx"));
 }
 
 USART::~USART()
 {
+    delete backend;
 }
 
 void USART::initialize()
 {
+    rdr = tdr = 0;
     ucsra = USART_UCSRA_UDRE;
+    ucsrb = 0;
+    idle_polls = 0;
+    rx_bytes = tx_bytes = 0;
 
     avr->register_handler(UDR,
         [this](AVR *avr, uint16_t reg, uint8_t data)
@@ -26,12 +47,17 @@ void USART::initialize()
                 data = rdr;
                 ucsra &= ~USART_UCSRA_RXC;
             }
+            else
+            {
+                poll_empty();
+            }
             return data;
         },
         [this](AVR *avr, uint16_t reg, uint8_t data)
         {
             if((ucsrb & USART_UCSRB_TXEN) && (ucsra & USART_UCSRA_UDRE))
             {
+                idle_polls = 0;
                 tdr = data;
                 ucsra &= ~USART_UCSRA_TXC;
                 ucsra &= ~USART_UCSRA_UDRE;
@@ -41,6 +67,7 @@ void USART::initialize()
     avr->register_handler(UCSRA,
         [this](AVR *avr, uint16_t reg, uint8_t data)
         {
+            poll_empty();
             return data | ucsra;
         },
         [this](AVR *avr, uint16_t reg, uint8_t data)
@@ -58,44 +85,123 @@ void USART::initialize()
         });
 }
 
-void USART::process()
+void USART::poll_empty()
+{
+    if((ucsrb & USART_UCSRB_RXEN) && (ucsra & USART_UCSRA_RXC) == 0 && idle_polls < USART_IDLE_POLLS)
+    {
+        idle_polls++;
+    }
+}
+
+bool USART::receiving() const
+{
+    return (ucsrb & USART_UCSRB_RXEN) != 0;
+}
+
+bool USART::idle() const
+{
+    return USART_IDLE_POLLS <= idle_polls;
+}
+
+size_t USART::state_size()
+{
+    return 5;
+}
+
+void USART::save(uint8_t *state)
+{
+    state[0] = rdr;
+    state[1] = tdr;
+    state[2] = ucsra;
+    state[3] = ucsrb;
+    state[4] = idle_polls;
+}
+
+void USART::load(const uint8_t *state)
+{
+    rdr = state[0];
+    tdr = state[1];
+    ucsra = state[2];
+    ucsrb = state[3];
+    idle_polls = state[4];
+}
+
+void USART::attach(Backend *_backend)
 {
-    fd_set readfds, writefds;
-    struct timeval tv = {0, 0};
+    delete backend;
+    backend = _backend;
+}
 
-    FD_ZERO(&readfds);
-    FD_ZERO(&writefds);
-    FD_SET(ifd, &readfds);
-    FD_SET(ofd, &writefds);
+Backend *USART::detach()
+{
+    Backend *old = backend;
+    backend = new NullBackend();
+    return old;
+}
 
-    if(0 < select((ifd < ofd ? ofd : ifd) + 1, &readfds, &writefds, NULL, &tv))
+void USART::process()
+{
+    if((ucsrb & USART_UCSRB_RXEN) && (ucsra & USART_UCSRA_RXC) == 0)
     {
-        if((ucsrb & USART_UCSRB_RXEN) && (ucsra & USART_UCSRA_RXC) == 0 && FD_ISSET(ifd, &readfds))
+        if(backend->poll_read(&rdr))
         {
-            if(read(ifd, &rdr, 1) == 1)
+            rx_bytes++;
+            Metrics::count(avr->metrics->rx_bytes);
+            idle_polls = 0;
+            ucsra |= USART_UCSRA_RXC;
+            if(ucsrb & USART_UCSRB_RXCIE)
             {
-                ucsra |= USART_UCSRA_RXC;
-                if(ucsrb & USART_UCSRB_RXCIE)
-                {
-                    avr->raise_irq(RXC);
-                }
+                avr->raise_irq(RXC);
             }
         }
-        if((ucsrb & USART_UCSRB_TXEN) && (ucsra & USART_UCSRA_UDRE) == 0 && FD_ISSET(ofd, &writefds))
+    }
+    if((ucsrb & USART_UCSRB_TXEN) && (ucsra & USART_UCSRA_UDRE) == 0)
+    {
+        if(backend->poll_write(tdr))
         {
-            if(write(ofd, &tdr, 1) == 1)
+            tail[tx_bytes++ % USART_TAIL_SIZE] = tdr;
+            Metrics::count(avr->metrics->tx_bytes);
+            ucsra |= USART_UCSRA_TXC;
+            if(ucsrb & USART_UCSRB_TXCIE)
+            {
+                avr->raise_irq(TXC);
+            }
+            ucsra |= USART_UCSRA_UDRE;
+            if(ucsrb & USART_UCSRB_UDRIE)
             {
-                ucsra |= USART_UCSRA_TXC;
-                if(ucsrb & USART_UCSRB_TXCIE)
-                {
-                    avr->raise_irq(TXC);
-                }
-                ucsra |= USART_UCSRA_UDRE;
-                if(ucsrb & USART_UCSRB_UDRIE)
-                {
-                    avr->raise_irq(DRE);
-                }
+                avr->raise_irq(DRE);
             }
         }
     }
 }
+
+uint16_t USART::data_register() const
+{
+    return UDR;
+}
+
+uint64_t USART::received() const
+{
+    return rx_bytes;
+}
+
+uint64_t USART::sent() const
+{
+    return tx_bytes;
+}
+
+bool USART::sent_ends_with(const std::string &pattern) const
+{
+    if(USART_TAIL_SIZE < pattern.size() || tx_bytes < pattern.size())
+    {
+        return false;
+    }
+    for(size_t i = 0; i < pattern.size(); i++)
+    {
+        if(tail[(tx_bytes - pattern.size() + i) % USART_TAIL_SIZE] != (uint8_t)pattern[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -4,8 +4,11 @@
 #define AVRE_USART_HH
 
 #include <sstream>
+#include <string>
 
 #include "avr.hh"
+#include "backend.hh"
+#include "registry.hh"
 
 #define USART_UCSRA_RXC   (0x80u)
 #define USART_UCSRA_TXC   (0x40u)
@@ -16,20 +19,52 @@
 #define USART_UCSRB_RXEN  (0x10u)
 #define USART_UCSRB_TXEN  (0x08u)
 
+// status polls with the receiver empty before the firmware counts as idle
+#define USART_IDLE_POLLS  (8u)
+// bytes sent that are kept for matching against
+#define USART_TAIL_SIZE   (64u)
+
 class USART : public Module
 {
 protected:
     AVR *avr;
-    int ifd, ofd;
+    Backend *backend;
     uint8_t rdr, tdr, ucsra, ucsrb;
+    uint8_t idle_polls;
     uint16_t UDR, UCSRA, UCSRB, UCSRC, RXC, DRE, TXC;
+    // counted since initialize(), outside of the saved state
+    uint64_t rx_bytes, tx_bytes;
+    uint8_t tail[USART_TAIL_SIZE];
+
+    void poll_empty();
 
 public:
-    USART(AVR *_avr, int _ifd, int _ofd, uint16_t _UDR, uint16_t _UCSRA, uint16_t _UCSRB, uint16_t _UCSRC, int _RXC, int _DRE, int _TXC);
+    USART(AVR *_avr, const ModuleConfig &config);
     virtual ~USART();
 
     virtual void initialize();
     virtual void process();
+
+    virtual size_t state_size();
+    virtual void save(uint8_t *state);
+    virtual void load(const uint8_t *state);
+
+    // takes ownership of the new backend
+    void attach(Backend *_backend);
+    // hands the current backend over to the caller
+    Backend *detach();
+
+    // the receiver is enabled, so input can reach the firmware
+    bool receiving() const;
+    // the firmware keeps polling for input that is not there
+    bool idle() const;
+
+    // the data space address of UDR, where received bytes are read
+    uint16_t data_register() const;
+    uint64_t received() const;
+    uint64_t sent() const;
+    // the bytes sent so far end with pattern, at most USART_TAIL_SIZE long
+    bool sent_ends_with(const std::string &pattern) const;
 };
 
 #endif
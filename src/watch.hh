@@ -0,0 +1,31 @@
+// watch.hh
+
+#ifndef AVRE_WATCH_HH
+#define AVRE_WATCH_HH
+
+#include <cstdint>
+
+#define WATCH_READ  (0x1u)
+#define WATCH_WRITE (0x2u)
+
+struct Watchpoint
+{
+    int id;
+    uint16_t addr;
+    uint16_t size;
+    // WATCH_READ and/or WATCH_WRITE
+    uint8_t kind;
+    // only accesses of this byte value trigger, -1 for any
+    int16_t value;
+};
+
+// the access that triggered last
+struct WatchHit
+{
+    int id;
+    uint16_t addr;
+    uint8_t data;
+    uint8_t kind;
+};
+
+#endif
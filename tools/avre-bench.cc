@@ -0,0 +1,184 @@
+// avre-bench.cc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <chrono>
+#include <string>
+
+#include "backend.hh"
+#include "machine.hh"
+#include "usart.hh"
+
+// output kept per benchmark, up to the first newline
+#define BENCH_OUTPUT (64u)
+
+// an endless stream of 'a' to 'z' in, the start of the output kept
+class BenchBackend : public Backend
+{
+protected:
+    uint8_t next;
+
+public:
+    std::string output;
+    bool line;
+
+    BenchBackend()
+        : Backend(), next(0), line(false)
+    {
+    }
+
+    virtual int poll_read(uint8_t *data)
+    {
+        *data = 'a' + next;
+        next = (next + 1) % 26;
+        return 1;
+    }
+
+    virtual int poll_write(uint8_t data)
+    {
+        if(!line && output.size() < BENCH_OUTPUT)
+        {
+            if(data == '\n')
+            {
+                line = true;
+            }
+            else
+            {
+                output += (char)data;
+            }
+        }
+        return 1;
+    }
+};
+
+void usage(const char *fn)
+{
+    fprintf(stderr, "usage: %s [-c cycles] [-b board] file...\n", fn);
+}
+
+static void json_string(FILE *f, const std::string &s)
+{
+    fputc('"', f);
+    for(size_t i = 0; i < s.size(); i++)
+    {
+        unsigned char c = s[i];
+        if(c == '"' || c == '\\')
+        {
+            fprintf(f, "\\%c", c);
+        }
+        else if(c < 0x20 || 0x7f <= c)
+        {
+            fprintf(f, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+// the type from the extension, the name from the base name
+static void identify(const char *fn, std::string &name, const char **type)
+{
+    const char *base = strrchr(fn, '/');
+    const char *ext;
+
+    base = base == NULL ? fn : base + 1;
+    ext = strrchr(base, '.');
+    name = ext == NULL ? base : std::string(base, ext - base);
+    if(ext != NULL && strcasecmp(ext, ".elf") == 0)
+    {
+        *type = "elf";
+    }
+    else if(ext != NULL && strcasecmp(ext, ".bin") == 0)
+    {
+        *type = "bin";
+    }
+    else
+    {
+        *type = "ihex";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Machine *machine;
+    BenchBackend *backend, *stream;
+    StopCondition stop;
+    std::chrono::steady_clock::time_point start;
+    std::string name;
+    const char *type, *board = NULL;
+    uint64_t cycles = 100000000;
+    double seconds;
+    char ch;
+
+    while((ch = getopt(argc, argv, "c:b:h")) != -1)
+    {
+        switch(ch)
+        {
+        case 'c':
+            cycles = strtoull(optarg, NULL, 0);
+            break;
+        case 'b':
+            board = optarg;
+            break;
+        case 'h':
+        case '?':
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+    if(argv[optind] == NULL)
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    stop.cycles = cycles;
+    printf("{\"cycles\": %llu, \"benchmarks\": [\n", (unsigned long long)cycles);
+    for(int i = optind; i < argc; i++)
+    {
+        identify(argv[i], name, &type);
+        machine = new Machine(new AVR(argv[i], type), board, true);
+        // every USART gets its own stream; only the first one's output is kept
+        backend = NULL;
+        for(Module *module : machine->peripherals())
+        {
+            USART *usart = dynamic_cast<USART *>(module);
+            if(usart != NULL)
+            {
+                stream = new BenchBackend();
+                usart->attach(stream);
+                if(backend == NULL)
+                {
+                    backend = stream;
+                }
+            }
+        }
+        machine->initialize();
+
+        start = std::chrono::steady_clock::now();
+        if(machine->run(stop) == STOP_FAULT)
+        {
+            fprintf(stderr, "%s: fault %d at %x\n", argv[i], machine->avr->fault, (uint32_t)machine->avr->pc << 1);
+            exit(1);
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("  {\"name\": ");
+        json_string(stdout, name);
+        printf(", \"instructions\": %llu, \"seconds\": %.6f, \"mips\": %.3f, \"ns_per_instruction\": %.3f, \"output\": ",
+            (unsigned long long)machine->instructions, seconds, machine->instructions / seconds / 1e6, seconds * 1e9 / machine->instructions);
+        json_string(stdout, backend == NULL ? std::string() : backend->output);
+        printf("}%s\n", i + 1 < argc ? "," : "");
+        fflush(stdout);
+        delete machine;
+    }
+    printf("]}\n");
+    return 0;
+}
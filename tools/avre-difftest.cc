@@ -0,0 +1,319 @@
+// avre-difftest.cc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "decoder.hh"
+#include "image.hh"
+#include "machine.hh"
+#include "opcode.hh"
+#include "tools.hh"
+
+// instructions kept for the report of a divergence
+#define DIFF_HISTORY (16u)
+
+// the last instructions one side ran, oldest first once full
+struct History
+{
+    uint16_t pc[DIFF_HISTORY];
+    uint16_t inst[DIFF_HISTORY];
+    uint16_t next[DIFF_HISTORY];
+    uint64_t count;
+
+    History()
+        : count(0)
+    {
+    }
+
+    void add(const AVR *avr)
+    {
+        pc[count % DIFF_HISTORY] = avr->pc;
+        inst[count % DIFF_HISTORY] = avr->flash.words[avr->pc];
+        next[count % DIFF_HISTORY] = avr->flash.words[(uint16_t)(avr->pc + 1)];
+        count++;
+    }
+};
+
+static Random rng;
+
+// FNV-1a, 64 bits at a time
+static uint64_t sram_hash(const AVR *avr)
+{
+    const uint64_t *p = (const uint64_t *)avr->sram.bytes;
+    uint64_t h = 0xcbf29ce484222325ull;
+
+    for(uint32_t i = 0; i < SRAM_SIZE_BYTES / 8; i++)
+    {
+        h = (h ^ p[i]) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+static void report(const char *what, uint64_t from, uint64_t to, const AVR *a, const AVR *b, const History &history,
+    const char *name_a, const char *name_b)
+{
+    uint64_t first = history.count < DIFF_HISTORY ? 0 : history.count - DIFF_HISTORY;
+    unsigned n = 0;
+    Instruction inst;
+    char text[128];
+
+    if(from + 1 == to)
+    {
+        printf("divergence at step %llu: %s %s\n", (unsigned long long)to, name_b, what);
+    }
+    else
+    {
+        printf("divergence between steps %llu and %llu: %s %s\n", (unsigned long long)from, (unsigned long long)to, name_b, what);
+    }
+    printf("  %-10s pc %05x cycle %llu SREG %02x SP %04x sram %016llx\n", name_a, (uint32_t)a->pc << 1,
+        (unsigned long long)a->cycle, a->sreg.bits, a->sp, (unsigned long long)sram_hash(a));
+    printf("  %-10s pc %05x cycle %llu SREG %02x SP %04x sram %016llx\n", name_b, (uint32_t)b->pc << 1,
+        (unsigned long long)b->cycle, b->sreg.bits, b->sp, (unsigned long long)sram_hash(b));
+
+    // the registers that differ are marked
+    printf("  registers:\n");
+    for(unsigned i = 0; i < 32; i++)
+    {
+        printf("    r%-2u %02x %02x%s", i, a->sram.bytes[i], b->sram.bytes[i], a->sram.bytes[i] != b->sram.bytes[i] ? " *" : "  ");
+        printf(i % 4 == 3 ? "\n" : " ");
+    }
+
+    printf("  differing data:");
+    for(uint32_t i = 32; i < SRAM_SIZE_BYTES && n < 8; i++)
+    {
+        if(a->sram.bytes[i] != b->sram.bytes[i])
+        {
+            printf(" %04x=%02x/%02x", i, a->sram.bytes[i], b->sram.bytes[i]);
+            n++;
+        }
+    }
+    printf("%s\n", n == 0 ? " none" : "");
+
+    printf("  last instructions (%s):\n", name_a);
+    for(uint64_t i = first; i < history.count; i++)
+    {
+        Instruction::decode(inst, history.pc[i % DIFF_HISTORY], history.inst[i % DIFF_HISTORY], history.next[i % DIFF_HISTORY]);
+        inst.format(text, sizeof(text));
+        printf("    %llu %05x %04x %s\n", (unsigned long long)i + 1, (uint32_t)history.pc[i % DIFF_HISTORY] << 1,
+            history.inst[i % DIFF_HISTORY], text);
+    }
+}
+
+static Machine *build(const EngineType *engine, const FlashImage &image, const char *board, const char *name,
+    const std::vector<uint8_t> &input)
+{
+    Machine *machine = new Machine(engine->create(image), board, true);
+
+    feed_usart(machine, name, input);
+    machine->initialize();
+    return machine;
+}
+
+// both engines run the firmware side by side and are compared every
+// interval steps
+static int run_firmware(const EngineType *ea, const EngineType *eb, const FlashImage &image, const char *board,
+    const char *usart, const std::vector<uint8_t> &input, uint64_t cycles, uint64_t interval)
+{
+    Machine *a = build(ea, image, board, usart, input);
+    Machine *b = build(eb, image, board, usart, input);
+    History history;
+    uint64_t checked = 0;
+    const char *what;
+    char buf[128];
+    int status = 0;
+
+    while(true)
+    {
+        history.add(a->avr);
+        a->process();
+        b->process();
+        if(a->steps - checked < interval && a->avr->fault == AVR_FAULT_NONE && a->avr->cycle < cycles)
+        {
+            continue;
+        }
+        what = compare(a->avr, b->avr, buf, sizeof(buf));
+        if(what != NULL)
+        {
+            report(what, checked, a->steps, a->avr, b->avr, history, ea->name, eb->name);
+            status = 1;
+            break;
+        }
+        checked = a->steps;
+        if(a->avr->fault != AVR_FAULT_NONE || cycles <= a->avr->cycle)
+        {
+            printf("%llu steps, %llu cycles, fault %d, sram %016llx: no divergence\n", (unsigned long long)a->steps,
+                (unsigned long long)a->avr->cycle, a->avr->fault, (unsigned long long)sram_hash(a->avr));
+            break;
+        }
+    }
+
+    delete a;
+    delete b;
+    return status;
+}
+
+// random states running random instructions, compared after every step;
+// a fault both sides take alike is stepped over
+static int run_random(const EngineType *ea, const EngineType *eb, unsigned sequences, unsigned length)
+{
+    FlashImage image;
+    AVR *a = ea->create(image), *b = eb->create(image);
+    Snapshot *snap = new Snapshot();
+    History history;
+    Quiet quiet;
+    const char *what = NULL;
+    char buf[128];
+    uint64_t start;
+    uint16_t inst;
+
+    // what unimplemented and illegal instructions print is not wanted
+    quiet.begin();
+
+    for(unsigned s = 0; s < sequences && what == NULL; s++)
+    {
+        start = rng.state;
+        for(uint32_t i = 0; i < FLASH_SIZE_WORDS; i++)
+        {
+            const Opcode &op = opcodes[rng.next() % OPCODE_COUNT];
+            inst = op.match | (rng.next() & ~op.mask);
+            a->flash.words[i] = b->flash.words[i] = inst;
+        }
+        for(uint32_t i = 0; i < SRAM_SIZE_BYTES; i += 8)
+        {
+            uint64_t r = rng.next();
+            memcpy(snap->sram.bytes + i, &r, 8);
+        }
+        snap->id = 0;
+        snap->pc = rng.next();
+        snap->cycle = 0;
+        snap->fault = AVR_FAULT_NONE;
+        snap->sleeping = false;
+        snap->stack_low = SRAM_SIZE_BYTES - 1;
+        snap->irq = 0;
+        a->restore(*snap);
+        b->restore(*snap);
+        history.count = 0;
+
+        for(unsigned i = 0; i < length && what == NULL; i++)
+        {
+            history.add(a);
+            a->process();
+            b->process();
+            what = compare(a, b, buf, sizeof(buf));
+            if(what == NULL && a->fault != AVR_FAULT_NONE)
+            {
+                a->pc = ++b->pc;
+                a->fault = b->fault = AVR_FAULT_NONE;
+            }
+            // nothing raises interrupts here, so nothing would wake them
+            a->sleeping = b->sleeping = false;
+        }
+        if(what != NULL)
+        {
+            quiet.end();
+            printf("sequence %u (-r 1 -s %#llx):\n", s, (unsigned long long)start);
+            report(what, history.count - 1, history.count, a, b, history, ea->name, eb->name);
+        }
+    }
+    quiet.end();
+    if(what == NULL)
+    {
+        printf("%u sequences of %u steps: no divergence\n", sequences, length);
+    }
+
+    delete snap;
+    delete a;
+    delete b;
+    return what == NULL ? 0 : 1;
+}
+
+void usage(const char *fn)
+{
+    fprintf(stderr, "usage: %s [-a engine] [-b engine] [-t type] [-B board] [-i input] [-u usart] [-c cycles] [-k interval] file\n", fn);
+    fprintf(stderr, "       %s [-a engine] [-b engine] -r sequences [-n steps] [-s seed]\n", fn);
+    fprintf(stderr, "engines:");
+    for(const EngineType &engine : engines)
+    {
+        fprintf(stderr, " %s", engine.name);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const EngineType *ea = &engines[0], *eb = &engines[ENGINE_COUNT - 1];
+    const char *type = "ihex", *board = NULL, *input = NULL, *usart = "usart0";
+    uint64_t cycles = 10000000, interval = 1;
+    unsigned sequences = 0, length = 1000;
+    FlashImage *image;
+    int status;
+    char ch;
+
+    while((ch = getopt(argc, argv, "a:b:t:B:i:u:c:k:r:n:s:h")) != -1)
+    {
+        switch(ch)
+        {
+        case 'a':
+            ea = find_engine(optarg);
+            break;
+        case 'b':
+            eb = find_engine(optarg);
+            break;
+        case 't':
+            type = optarg;
+            break;
+        case 'B':
+            board = optarg;
+            break;
+        case 'i':
+            input = optarg;
+            break;
+        case 'u':
+            usart = optarg;
+            break;
+        case 'c':
+            cycles = strtoull(optarg, NULL, 0);
+            break;
+        case 'k':
+            interval = strtoull(optarg, NULL, 0);
+            if(interval == 0)
+            {
+                interval = 1;
+            }
+            break;
+        case 'r':
+            sequences = atoi(optarg);
+            break;
+        case 'n':
+            length = atoi(optarg);
+            break;
+        case 's':
+            rng.seed(optarg);
+            break;
+        case 'h':
+        case '?':
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+
+    if(sequences != 0)
+    {
+        return run_random(ea, eb, sequences, length);
+    }
+    if(argv[optind] == NULL)
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+    image = new FlashImage(argv[optind], type);
+    status = run_firmware(ea, eb, *image, board, usart, read_input(input), cycles, interval);
+    delete image;
+    return status;
+}
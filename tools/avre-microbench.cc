@@ -0,0 +1,170 @@
+// avre-microbench.cc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <vector>
+
+#include "image.hh"
+#include "opcode.hh"
+#include "tools.hh"
+
+static Random rng;
+
+// random registers, I/O space and SREG, the rest of SRAM as filled once
+static void randomize(Snapshot &snap)
+{
+    snap.id = 0;
+    snap.pc = rng.next();
+    snap.cycle = 0;
+    snap.fault = AVR_FAULT_NONE;
+    snap.sleeping = false;
+    snap.stack_low = SRAM_SIZE_BYTES - 1;
+    snap.irq = 0;
+    for(unsigned i = 0; i < REGS_SIZE_BYTES; i += 8)
+    {
+        uint64_t r = rng.next();
+        memcpy(snap.sram.bytes + i, &r, 8);
+    }
+}
+
+void usage(const char *fn)
+{
+    fprintf(stderr, "usage: %s [-t trials] [-n iterations] [-s seed] [name...]\n", fn);
+}
+
+int main(int argc, char *argv[])
+{
+    FlashImage image;
+    AVR *cores[ENGINE_COUNT];
+    Snapshot snap;
+    std::vector<const char *> names;
+    unsigned trials = 256, iterations = 100000, mismatches = 0;
+    uint16_t inst = 0, pc = 0, next;
+    int taken[ENGINE_COUNT];
+    const char *diff, *differs = NULL;
+    Quiet quiet;
+    bool wanted;
+    char buf[128];
+    char ch;
+
+    while((ch = getopt(argc, argv, "t:n:s:h")) != -1)
+    {
+        switch(ch)
+        {
+        case 't':
+            trials = atoi(optarg);
+            break;
+        case 'n':
+            iterations = atoi(optarg);
+            break;
+        case 's':
+            rng.seed(optarg);
+            break;
+        case 'h':
+        case '?':
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+    for(int i = optind; i < argc; i++)
+    {
+        names.push_back(argv[i]);
+    }
+
+    for(unsigned v = 0; v < ENGINE_COUNT; v++)
+    {
+        cores[v] = engines[v].create(image);
+    }
+    for(uint32_t i = 0; i < SRAM_SIZE_BYTES; i += 8)
+    {
+        uint64_t r = rng.next();
+        memcpy(snap.sram.bytes + i, &r, 8);
+    }
+
+    printf("%-8s", "handler");
+    for(unsigned v = 0; v < ENGINE_COUNT; v++)
+    {
+        printf(" %12s", engines[v].name);
+    }
+    printf("  (ns/op)\n");
+
+    for(const Opcode &op : opcodes)
+    {
+        wanted = names.empty();
+        for(const char *name : names)
+        {
+            wanted |= strcasecmp(name, op.name) == 0;
+        }
+        if(!wanted)
+        {
+            continue;
+        }
+
+        // each trial is a new encoding in a new state, run by every engine;
+        // the complaints of unimplemented handlers are not wanted here
+        diff = NULL;
+        quiet.begin();
+        for(unsigned t = 0; t < trials && diff == NULL; t++)
+        {
+            randomize(snap);
+            inst = op.match | (rng.next() & ~op.mask);
+            pc = snap.pc;
+            next = rng.next();
+            for(unsigned v = 0; v < ENGINE_COUNT; v++)
+            {
+                cores[v]->restore(snap);
+                cores[v]->flash.words[pc] = inst;
+                cores[v]->flash.words[(uint16_t)(pc + 1)] = next;
+                cores[v]->pc = pc + 1;
+                taken[v] = engines[v].execute(cores[v], inst);
+            }
+            if(cores[0]->fault != AVR_FAULT_NONE)
+            {
+                break;
+            }
+            for(unsigned v = 1; v < ENGINE_COUNT && diff == NULL; v++)
+            {
+                if(taken[0] != taken[v])
+                {
+                    snprintf(buf, sizeof(buf), "cycles %d, not %d", taken[v], taken[0]);
+                    diff = buf;
+                }
+                else
+                {
+                    diff = compare(cores[0], cores[v], buf, sizeof(buf));
+                }
+                differs = engines[v].name;
+            }
+        }
+        quiet.end();
+        if(diff != NULL)
+        {
+            fprintf(stderr, "%s: %s differs on %04x at %x: %s\n", op.name, differs, inst, (uint32_t)pc << 1, diff);
+            mismatches++;
+        }
+
+        printf("%-8s", op.name);
+        if(cores[0]->fault != AVR_FAULT_NONE)
+        {
+            printf(" unimplemented\n");
+            continue;
+        }
+        // timed on the last trial's encoding and state
+        for(unsigned v = 0; v < ENGINE_COUNT; v++)
+        {
+            cores[v]->restore(snap);
+            printf(" %12.2f", engines[v].measure(cores[v], inst, pc, iterations));
+        }
+        printf("%s\n", diff == NULL ? "" : "  MISMATCH");
+    }
+
+    for(unsigned v = 0; v < ENGINE_COUNT; v++)
+    {
+        delete cores[v];
+    }
+    return mismatches == 0 ? 0 : 1;
+}
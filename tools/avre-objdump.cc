@@ -0,0 +1,104 @@
+// avre-objdump.cc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <stdint.h>
+
+#include "avr.hh"
+#include "decoder.hh"
+#include "image.hh"
+#include "symbols.hh"
+
+void usage(const char *fn)
+{
+    fprintf(stderr, "usage: %s [-t type] [-y symbols] [-s start] [-e end] file\n", fn);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *type = "ihex", *symbols = NULL;
+    uint32_t start = 0, end = UINT32_MAX, pc;
+    const FLASH *flash;
+    const Symbol *symbol;
+    FlashImage *image;
+    Symbols *syms;
+    Instruction inst;
+    char text[128];
+    char ch;
+
+    while((ch = getopt(argc, argv, "t:y:s:e:h")) != -1)
+    {
+        switch(ch)
+        {
+        case 't':
+            type = optarg;
+            break;
+        case 'y':
+            symbols = optarg;
+            break;
+        case 's':
+            start = strtoul(optarg, NULL, 0);
+            break;
+        case 'e':
+            end = strtoul(optarg, NULL, 0);
+            break;
+        case 'h':
+        case '?':
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+    if(argv[optind] == NULL)
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    image = new FlashImage(argv[optind], type);
+    flash = &image->map();
+    if(symbols == NULL && strcasecmp(type, "elf") == 0)
+    {
+        symbols = argv[optind];
+    }
+    syms = symbols == NULL ? new Symbols() : new Symbols(symbols);
+
+    // addresses are in bytes; without an end, up to the last word that
+    // is not zero, rather than through the blank rest of flash
+    if(end == UINT32_MAX)
+    {
+        for(pc = FLASH_SIZE_WORDS; pc != 0 && flash->words[pc - 1] == 0; pc--)
+        {
+        }
+        end = pc << 1;
+    }
+    if(FLASH_SIZE_BYTES < end)
+    {
+        end = FLASH_SIZE_BYTES;
+    }
+
+    for(pc = start >> 1; pc < end >> 1; pc += inst.words)
+    {
+        symbol = syms->find(pc << 1);
+        if(symbol != NULL && symbol->addr == pc << 1)
+        {
+            printf("\n%08x <%s>:\n", pc << 1, symbol->name.c_str());
+        }
+        Instruction::decode(inst, pc, flash->words[pc], flash->words[(pc + 1) & (FLASH_SIZE_WORDS - 1)]);
+        inst.format(text, sizeof(text), syms);
+        if(inst.words == 2)
+        {
+            printf("%8x:\t%02x %02x %02x %02x \t%s\n", pc << 1, inst.inst & 0xff, inst.inst >> 8, inst.next & 0xff, inst.next >> 8, text);
+        }
+        else
+        {
+            printf("%8x:\t%02x %02x       \t%s\n", pc << 1, inst.inst & 0xff, inst.inst >> 8, text);
+        }
+    }
+
+    delete syms;
+    delete image;
+    return 0;
+}
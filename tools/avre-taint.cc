@@ -0,0 +1,106 @@
+// avre-taint.cc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <vector>
+
+#include "engine.hh"
+#include "image.hh"
+#include "machine.hh"
+#include "symbols.hh"
+#include "taint.hh"
+#include "tools.hh"
+#include "usart.hh"
+
+// the label of what the fuzzed USART receives
+#define TAINT_LABEL_INPUT (0x01u)
+
+void usage(const char *fn)
+{
+    fprintf(stderr, "usage: %s [-t type] [-b board] [-u usart] [-i input] [-c cycles] [-y symbols] [-a] file\n", fn);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *type = "ihex", *board = NULL, *name = "usart0", *input = NULL, *symbols = NULL;
+    uint64_t cycles = 100000000;
+    bool address = false;
+    std::vector<uint8_t> data;
+    Engine<TaintHooks> *engine;
+    USART *usart;
+    FlashImage *image;
+    Machine *machine;
+    Symbols *syms;
+    char ch;
+
+    while((ch = getopt(argc, argv, "t:b:u:i:c:y:ah")) != -1)
+    {
+        switch(ch)
+        {
+        case 't':
+            type = optarg;
+            break;
+        case 'b':
+            board = optarg;
+            break;
+        case 'u':
+            name = optarg;
+            break;
+        case 'i':
+            input = optarg;
+            break;
+        case 'c':
+            cycles = strtoull(optarg, NULL, 0);
+            break;
+        case 'y':
+            symbols = optarg;
+            break;
+        case 'a':
+            address = true;
+            break;
+        case 'h':
+        case '?':
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+    if(argv[optind] == NULL)
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    image = new FlashImage(argv[optind], type);
+    if(symbols == NULL && strcasecmp(type, "elf") == 0)
+    {
+        symbols = argv[optind];
+    }
+    syms = symbols == NULL ? new Symbols() : new Symbols(symbols);
+    data = read_input(input);
+
+    engine = new Engine<TaintHooks>(*image);
+    engine->hooks.address = address;
+    machine = new Machine(engine, board, true);
+    usart = feed_usart(machine, name, data);
+    engine->hooks.add_source(usart->data_register(), TAINT_LABEL_INPUT);
+    machine->initialize();
+
+    // until the firmware waits for input that is not coming, faults or
+    // runs out of cycles
+    while(engine->fault == AVR_FAULT_NONE && engine->cycle < cycles && !(usart->idle() && usart->received() == data.size()))
+    {
+        machine->process();
+    }
+    printf("%llu steps, %llu cycles, fault %d, %llu of %zu bytes received\n", (unsigned long long)machine->steps,
+        (unsigned long long)engine->cycle, engine->fault, (unsigned long long)usart->received(), data.size());
+    engine->hooks.report(stdout, engine, *syms);
+
+    delete machine;
+    delete syms;
+    delete image;
+    return 0;
+}
@@ -0,0 +1,140 @@
+// avre-trace.cc
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdint.h>
+
+#include "avr.hh"
+#include "decoder.hh"
+#include "image.hh"
+#include "trace.hh"
+
+void usage(const char *fn)
+{
+    fprintf(stderr, "usage: %s [-w] [-c] [-p lo:hi] [-a addr] [-n count] [-f firmware [-t type]] trace\n", fn);
+    fprintf(stderr, "       %s -s trace\n", fn);
+}
+
+int main(int argc, char *argv[])
+{
+    TraceReader *reader;
+    TraceRecord record;
+    FlashImage *image = NULL;
+    const FLASH *flash = NULL;
+    const char *firmware = NULL, *type = "ihex";
+    Instruction inst;
+    char text[128];
+    uint64_t count = UINT64_MAX, steps = 0, writes = 0, syncs = 0, cycle = 0;
+    uint32_t lo = 0, hi = UINT32_MAX;
+    long addr = -1;
+    bool show_writes = false, show_cycles = false, summary = false;
+    char *end;
+    char ch;
+
+    while((ch = getopt(argc, argv, "wcp:a:n:f:t:sh")) != -1)
+    {
+        switch(ch)
+        {
+        case 'w':
+            show_writes = true;
+            break;
+        case 'c':
+            show_cycles = true;
+            break;
+        case 'p':
+            lo = strtoul(optarg, &end, 0);
+            hi = *end == ':' ? strtoul(end + 1, NULL, 0) : lo + 1;
+            break;
+        case 'a':
+            addr = strtol(optarg, NULL, 0);
+            show_writes = true;
+            break;
+        case 'n':
+            count = strtoull(optarg, NULL, 0);
+            break;
+        case 'f':
+            firmware = optarg;
+            break;
+        case 't':
+            type = optarg;
+            break;
+        case 's':
+            summary = true;
+            break;
+        case 'h':
+        case '?':
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+    if(argv[optind] == NULL)
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    reader = new TraceReader(argv[optind]);
+    // the trace has pcs only; the firmware it was recorded from says what
+    // ran there
+    if(firmware != NULL)
+    {
+        image = new FlashImage(firmware, type);
+        flash = &image->map();
+    }
+    if(show_writes && (reader->flags & TRACE_FLAG_WRITES) == 0)
+    {
+        fprintf(stderr, "%s: recorded without writes\n", argv[optind]);
+    }
+
+    // pc filters are in byte addresses like everywhere else
+    while(count != 0 && reader->next(record))
+    {
+        switch(record.kind)
+        {
+        case TRACE_STEP:
+            steps++;
+            if(!summary && addr < 0 && lo <= (uint32_t)record.pc << 1 && ((uint32_t)record.pc << 1) < hi)
+            {
+                if(flash != NULL)
+                {
+                    Instruction::decode(inst, record.pc, flash->words[record.pc], flash->words[(uint16_t)(record.pc + 1)]);
+                    inst.format(text, sizeof(text));
+                    printf("%llu %05x %s\n", (unsigned long long)record.step, (uint32_t)record.pc << 1, text);
+                }
+                else
+                {
+                    printf("%llu %05x\n", (unsigned long long)record.step, (uint32_t)record.pc << 1);
+                }
+                count--;
+            }
+            break;
+        case TRACE_WRITE:
+            writes++;
+            if(!summary && show_writes && (addr < 0 || addr == record.addr) && lo <= (uint32_t)record.pc << 1 && ((uint32_t)record.pc << 1) < hi)
+            {
+                printf("%llu %05x [%04x] <- %02x\n", (unsigned long long)record.step - 1, (uint32_t)record.pc << 1, record.addr, record.data);
+                count--;
+            }
+            break;
+        case TRACE_CYCLE:
+            syncs++;
+            cycle = record.cycle;
+            if(!summary && show_cycles)
+            {
+                printf("%llu cycle %llu\n", (unsigned long long)record.step, (unsigned long long)record.cycle);
+            }
+            break;
+        }
+    }
+
+    if(summary)
+    {
+        printf("steps %llu\nwrites %llu\ncycle syncs %llu\nlast cycle %llu\n",
+            (unsigned long long)steps, (unsigned long long)writes, (unsigned long long)syncs, (unsigned long long)cycle);
+    }
+    delete reader;
+    delete image;
+    return 0;
+}
@@ -0,0 +1,262 @@
+// tools.hh
+
+#ifndef AVRE_TOOLS_HH
+#define AVRE_TOOLS_HH
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+#include "backend.hh"
+#include "engine.hh"
+#include "image.hh"
+#include "instrumented.hh"
+#include "machine.hh"
+#include "usart.hh"
+
+// what the tools in tools/ share; a header only, since make links every
+// tools/<name>.cc into a program of its own
+
+// xorshift64*, fixed seed, so runs and what they find repeat; any state
+// but 0 is a seed
+struct Random
+{
+    uint64_t state;
+
+    Random()
+        : state(0x9e3779b97f4a7c15ull)
+    {
+    }
+
+    uint64_t next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dull;
+    }
+
+    // -s, which exits on 0
+    void seed(const char *arg)
+    {
+        state = strtoull(arg, NULL, 0);
+        if(state == 0)
+        {
+            fprintf(stderr, "seed must not be 0\n");
+            exit(1);
+        }
+    }
+};
+
+// a core whose dispatch table can be driven one handler at a time; it
+// steps as CPU does
+template<class CPU>
+class Dispatch : public CPU
+{
+public:
+    Dispatch(const FlashImage &image)
+        : CPU(image)
+    {
+    }
+
+    // as step() runs it, with pc already past the instruction
+    int execute(uint16_t inst)
+    {
+        return CPU::instructions[inst](this, inst);
+    }
+};
+
+struct EngineType
+{
+    const char *name;
+    AVR *(*create)(const FlashImage &image);
+    int (*execute)(AVR *avr, uint16_t inst);
+    // ns per execution of inst at pc, n times over
+    double (*measure)(AVR *avr, uint16_t inst, uint16_t pc, unsigned n);
+};
+
+template<class CPU>
+AVR *create_engine(const FlashImage &image)
+{
+    return new Dispatch<CPU>(image);
+}
+
+template<class CPU>
+int execute_engine(AVR *avr, uint16_t inst)
+{
+    return ((Dispatch<CPU> *)avr)->execute(inst);
+}
+
+template<class CPU>
+double measure_engine(AVR *avr, uint16_t inst, uint16_t pc, unsigned n)
+{
+    Dispatch<CPU> *cpu = (Dispatch<CPU> *)avr;
+    std::chrono::steady_clock::time_point start;
+    volatile int sink = 0;
+
+    start = std::chrono::steady_clock::now();
+    for(unsigned i = 0; i < n; i++)
+    {
+        cpu->pc = pc + 1;
+        sink += cpu->execute(inst);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / n;
+}
+
+#define ENGINE_TYPE(name, CPU) {name, create_engine<CPU>, execute_engine<CPU>, measure_engine<CPU>}
+
+// every execution engine, the reference the others are held to first; a
+// new engine or handler fast path is added here
+static const EngineType engines[] = {
+    ENGINE_TYPE("reference", AVR),
+    ENGINE_TYPE("engine", Engine<NoHooks>),
+    ENGINE_TYPE("instrumented", Instrumented),
+};
+
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+inline const EngineType *find_engine(const char *name)
+{
+    for(const EngineType &engine : engines)
+    {
+        if(strcasecmp(engine.name, name) == 0)
+        {
+            return &engine;
+        }
+    }
+    fprintf(stderr, "unknown engine -- '%s'\n", name);
+    exit(1);
+}
+
+// the first difference in pc, cycle, fault, SREG, SP, the register file
+// and SRAM, or NULL
+inline const char *compare(const AVR *a, const AVR *b, char *buf, size_t size)
+{
+    if(a->pc != b->pc)
+    {
+        snprintf(buf, size, "pc %x, not %x", (uint32_t)b->pc << 1, (uint32_t)a->pc << 1);
+        return buf;
+    }
+    if(a->cycle != b->cycle)
+    {
+        snprintf(buf, size, "cycle %llu, not %llu", (unsigned long long)b->cycle, (unsigned long long)a->cycle);
+        return buf;
+    }
+    if(a->fault != b->fault || a->sleeping != b->sleeping)
+    {
+        snprintf(buf, size, "fault %d sleeping %d, not %d %d", b->fault, b->sleeping, a->fault, a->sleeping);
+        return buf;
+    }
+    if(a->sreg.bits != b->sreg.bits)
+    {
+        snprintf(buf, size, "SREG %02x, not %02x", b->sreg.bits, a->sreg.bits);
+        return buf;
+    }
+    if(a->sp != b->sp)
+    {
+        snprintf(buf, size, "SP %04x, not %04x", b->sp, a->sp);
+        return buf;
+    }
+    if(memcmp(a->sram.bytes, b->sram.bytes, SRAM_SIZE_BYTES) != 0)
+    {
+        for(uint32_t i = 0; i < SRAM_SIZE_BYTES; i++)
+        {
+            if(a->sram.bytes[i] != b->sram.bytes[i])
+            {
+                snprintf(buf, size, "%s %04x = %02x, not %02x", i < 32 ? "register" : "data", i, b->sram.bytes[i], a->sram.bytes[i]);
+                break;
+            }
+        }
+        return buf;
+    }
+    return NULL;
+}
+
+// stderr sent to /dev/null and back, for what unimplemented and illegal
+// instructions print while random code runs
+class Quiet
+{
+    int quiet;
+    int console;
+
+public:
+    Quiet()
+    {
+        quiet = open("/dev/null", O_WRONLY);
+        console = dup(2);
+        if(quiet < 0 || console < 0)
+        {
+            perror("/dev/null");
+            exit(1);
+        }
+    }
+
+    ~Quiet()
+    {
+        end();
+        close(quiet);
+        close(console);
+    }
+
+    void begin()
+    {
+        fflush(stderr);
+        dup2(quiet, 2);
+    }
+
+    void end()
+    {
+        fflush(stderr);
+        dup2(console, 2);
+    }
+};
+
+// the bytes of a USART input file, none without one
+inline std::vector<uint8_t> read_input(const char *fn)
+{
+    std::vector<uint8_t> input;
+    FILE *f;
+    int c;
+
+    if(fn == NULL)
+    {
+        return input;
+    }
+    f = fopen(fn, "rb");
+    if(f == NULL)
+    {
+        perror(fn);
+        exit(1);
+    }
+    while((c = fgetc(f)) != EOF)
+    {
+        input.push_back(c);
+    }
+    fclose(f);
+    return input;
+}
+
+// the USART name receives input, every other one is cut off from the
+// process's descriptors; exits if there is no such USART
+inline USART *feed_usart(Machine *machine, const char *name, const std::vector<uint8_t> &input)
+{
+    MemoryBackend *backend = new MemoryBackend();
+    USART *usart;
+
+    backend->feed(input.data(), input.size());
+    usart = machine->isolate(name, backend);
+    if(usart == NULL)
+    {
+        fprintf(stderr, "no such usart -- '%s'\n", name);
+        exit(1);
+    }
+    return usart;
+}
+
+#endif